@@ -0,0 +1,254 @@
+#ifndef MKVDB_BTREE_BTREE_HPP_
+#define MKVDB_BTREE_BTREE_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "Node.hpp"
+#include "ValueReader.hpp"
+#include "ValueWriter.hpp"
+#include "WriteBatch.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    /// B+tree mapping keys to values, stored in the pages of a pager.
+    ///
+    /// The keys are ordered by the lexicographical order of their bytes (see CompareKeys). The
+    /// root of the tree always stays on the same page, so a tree is identified by the index of its
+    /// root page.
+    ///
+    /// A value too large to fit in a leaf with its key is stored out of line, in an extent of
+    /// consecutive overflow pages, and its cell only keeps a reference to the extent and the first
+    /// bytes of the value (see OverflowReference).
+    ///
+    /// Keys inserted in increasing order take a fast path: the path to the rightmost leaf is
+    /// cached, so an append doesn't descend from the root, and a rightmost node that is full is
+    /// split by starting a new node instead of moving half of its cells. A tree must therefore
+    /// only be modified through one BTree object at a time.
+    class BTree
+    {
+    public:
+        /// Create a new empty tree.
+        /// @param pager Pager where the tree is created.
+        /// @return The index of the root page of the new tree.
+        static pager::Page::PageIndex Create(pager::Pager& pager);
+
+        /// Returns the maximum size of a key/value pair stored in a leaf of a tree whose pages
+        /// have a content of the given size.
+        /// @param content_size Size of the content of the pages.
+        static common::ValueSize MaxKeyValueSize(common::FileOffset content_size);
+
+        /// Returns the maximum size of a key of a tree whose pages have a content of the given
+        /// size.
+        /// @param content_size Size of the content of the pages.
+        static common::ValueSize MaxKeySize(common::FileOffset content_size);
+
+        /// Constructor. Open an existing tree.
+        /// @param pager Pager containing the tree.
+        /// @param root_index Index of the root page of the tree.
+        BTree(pager::Pager& pager, pager::Page::PageIndex root_index);
+
+        /// Returns the index of the root page of the tree.
+        inline pager::Page::PageIndex root_index() const { return root_index_; }
+
+        /// Returns the maximum size of a key.
+        inline common::ValueSize max_key_size() const { return max_key_size_; }
+
+        /// Returns the maximum size of a key/value pair stored in a leaf. The value of a larger
+        /// pair is stored in overflow pages.
+        inline common::ValueSize max_key_value_size() const { return max_key_value_size_; }
+
+        /// Returns the height of the tree. A tree with a single leaf node has a height of 1.
+        std::size_t height() const;
+
+        /// Get the value associated with a key.
+        /// @return The value or std::nullopt if the key is not in the tree.
+        std::optional<std::vector<std::byte>> Get(common::ConstByteSpan key) const;
+
+        /// Get the values associated with many keys. The keys are sorted and the tree is descended
+        /// once for all of them: each node on their paths is read once, and the nodes of each
+        /// level are prefetched before any of them is read.
+        /// @return The values, in the order of the keys. A value is std::nullopt if its key is not
+        /// in the tree.
+        std::vector<std::optional<std::vector<std::byte>>>
+          MultiGet(std::span<const common::ConstByteSpan> keys) const;
+
+        /// Insert a key/value pair in the tree. If the key is already in the tree its value is
+        /// replaced.
+        /// @throw common::MkvDBException if the key or the value is too large.
+        void Put(common::ConstByteSpan key, common::ConstByteSpan value);
+
+        /// Open a stream reading the value associated with a key by chunks.
+        /// @return The reader or std::nullopt if the key is not in the tree.
+        std::optional<ValueReader> OpenValueReader(common::ConstByteSpan key) const;
+
+        /// Open a stream writing the value of a key by chunks. The value is inserted in the tree
+        /// when the writer is committed.
+        /// @param value_size Size of the whole value.
+        /// @throw common::MkvDBException if the key or the value is too large.
+        ValueWriter OpenValueWriter(common::ConstByteSpan key, common::FileOffset value_size);
+
+        /// Delete a key and its value from the tree.
+        /// @return True if the key was in the tree, false otherwise.
+        bool Delete(common::ConstByteSpan key);
+
+        /// Apply a batch of puts and deletes, then write the modified pages of the pager with a
+        /// single sync of the file. The operations are applied in the order of their keys, and
+        /// when a key appears several times only its last operation is applied.
+        ///
+        /// The batch is checked before the tree is modified, so an invalid batch leaves the tree
+        /// unchanged. The pages modified before the call, by this tree or by other trees of the
+        /// pager, are written along with the batch.
+        /// @throw common::MkvDBException if the pager is read-only or if a key or a value of the
+        /// batch is too large.
+        void Write(const WriteBatch& batch);
+
+    private:
+        friend class Cursor;
+        friend class InterleavedLookup;
+        friend class ValueWriter;
+
+        /// The split point of a leaf is moved by up to size / SEPARATOR_WINDOW_DIVISOR cells around
+        /// the middle of the leaf to find a shorter separator.
+        static constexpr std::size_t SEPARATOR_WINDOW_DIVISOR = 8;
+
+        /// A node whose cells use less than 1 / UNDERFLOW_DIVISOR of its space is rebalanced with a
+        /// sibling.
+        static constexpr std::size_t UNDERFLOW_DIVISOR = 4;
+
+        /// Two nodes are merged only if the merged node uses at most MERGE_LIMIT_PERCENT of its
+        /// space. Otherwise they share their cells. Together with the split of full nodes in two
+        /// halves, this leaves a margin on both sides so alternate insertions and deletions at the
+        /// limit don't split and merge the same nodes over and over.
+        static constexpr std::size_t MERGE_LIMIT_PERCENT = 75;
+
+        /// Entry of the path followed from the root to a leaf.
+        struct PathEntry
+        {
+            /// Page of an inner node.
+            std::shared_ptr<pager::Page> page;
+
+            /// Position of the child followed in the node.
+            NodeHeader::NodeSize position;
+        };
+
+        /// Result of a node split.
+        struct SplitResult
+        {
+            /// Separator key between the split node and its new right sibling.
+            std::vector<std::byte> separator;
+
+            /// Page of the new right sibling.
+            std::shared_ptr<pager::Page> right;
+        };
+
+        /// Keys bounding a node in the tree. All the keys of the node are greater or equal to the
+        /// lower fence and smaller than the upper fence. A node at the left or right edge of the
+        /// tree has no lower or upper fence.
+        struct Fences
+        {
+            std::optional<std::vector<std::byte>> lower;
+            std::optional<std::vector<std::byte>> upper;
+        };
+
+        /// Descend from the root to the leaf that may contain a key.
+        /// @param key The key searched.
+        /// @param path If not nullptr, receives the inner nodes traversed.
+        /// @return The page of the leaf.
+        std::shared_ptr<pager::Page> FindLeaf(common::ConstByteSpan key,
+                                              std::vector<PathEntry>* path) const;
+
+        /// Insert or replace the cell of a key in its leaf.
+        /// @param has_overflow Indicate if the value describes an overflow.
+        void PutCell(common::ConstByteSpan key, common::ConstByteSpan value, bool has_overflow);
+
+        /// Insert a cell in a node, splitting the node and its ancestors when it is full.
+        /// @param path Inner nodes traversed from the root to the node.
+        /// @param page Page of the node.
+        /// @param pos Position of the new cell in the node.
+        /// @param has_overflow Indicate if the value of the new cell describes an overflow.
+        void InsertCell(std::vector<PathEntry>& path,
+                        std::shared_ptr<pager::Page> page,
+                        NodeHeader::NodeSize pos,
+                        common::ConstByteSpan key,
+                        common::ConstByteSpan value,
+                        bool has_overflow);
+
+        /// Move the content of the root node to a new child, making the root an inner node with a
+        /// single child. This is how the tree grows while its root stays on the same page.
+        /// @return The page of the new child.
+        std::shared_ptr<pager::Page> GrowRoot(pager::Page& root);
+
+        /// Indicate if a key is greater than all the keys of a leaf. An empty leaf has no last
+        /// key, so no key is after it.
+        static bool IsAfterLastKey(const Node& leaf, common::ConstByteSpan key);
+
+        /// Returns the fences of the node reached by a path.
+        /// @param path Inner nodes traversed from the root to the node.
+        static Fences FindFences(const std::vector<PathEntry>& path);
+
+        /// Split a full node in two while inserting a new cell. The node keeps the lower half of
+        /// the cells and the upper half moves to a new right sibling, except when the new cell is
+        /// appended to the rightmost node of its level: the new sibling then only gets the new
+        /// cell. The prefix of each half is the prefix shared by its fences.
+        /// @param node Node to split.
+        /// @param fences Fences of the node.
+        /// @param pos Position of the new cell in the node.
+        /// @param has_overflow Indicate if the value of the new cell describes an overflow.
+        SplitResult Split(Node& node,
+                          const Fences& fences,
+                          NodeHeader::NodeSize pos,
+                          common::ConstByteSpan key,
+                          common::ConstByteSpan value,
+                          bool has_overflow);
+
+        /// Indicate if the cells of a node use too little of its space, so the node should be
+        /// merged with a sibling or borrow cells from it.
+        static bool IsUnderflowing(const Node& node);
+
+        /// Merge an underflowing node with a sibling, or share their cells evenly if they are too
+        /// full to merge, and continue with the ancestors that underflow in turn. The root is
+        /// replaced by its only child when it has a single one left.
+        /// @param path Inner nodes traversed from the root to the node.
+        /// @param page Page of the node.
+        void Rebalance(std::vector<PathEntry>& path, std::shared_ptr<pager::Page> page);
+
+        /// Merge two sibling nodes in the left one, or share their cells evenly between them.
+        /// @param path Inner nodes traversed from the root to the parent.
+        /// @param parent_page Page of the parent of the nodes.
+        /// @param position Position of the separator of the nodes in the parent.
+        /// @param left_page Page of the left node.
+        /// @param right_page Page of the right node.
+        /// @return True if the nodes were merged, false if they shared their cells.
+        bool MergeOrBorrow(std::vector<PathEntry>& path,
+                           std::shared_ptr<pager::Page> parent_page,
+                           NodeHeader::NodeSize position,
+                           pager::Page& left_page,
+                           pager::Page& right_page);
+
+        /// Free the overflow pages of a value.
+        /// @param cell_value Value of the cell describing the overflow.
+        void FreeOverflow(common::ConstByteSpan cell_value);
+
+        pager::Pager& pager_;
+        pager::Page::PageIndex root_index_;
+        common::ValueSize max_key_size_;
+        common::ValueSize max_key_value_size_;
+
+        /// Path from the root to the rightmost leaf and page of that leaf, cached for the appends.
+        /// They are reset when a node splits, and found again by the next insertion that descends
+        /// to the rightmost leaf.
+        std::vector<PathEntry> append_path_;
+        std::shared_ptr<pager::Page> append_leaf_;
+    };
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_BTREE_HPP_
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef MKVDB_BTREE_BULK_LOADER_HPP_
+#define MKVDB_BTREE_BULK_LOADER_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "NodeHeader.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    /// Builder of a new B+tree from key/value pairs added in increasing order of their keys.
+    ///
+    /// The leaves are filled one after the other up to a fill factor and the inner levels are
+    /// built bottom-up as the nodes below them are completed, so there are no splits and the
+    /// pages are allocated, and written, in a single sequential pass. Each node gets the prefix
+    /// shared by its fences, like the nodes built by BTree::Put.
+    class BulkLoader
+    {
+    public:
+        /// Default fill factor of the nodes.
+        static constexpr double DEFAULT_FILL_FACTOR = 0.9;
+
+        /// Constructor.
+        /// @param pager Pager where the tree is created.
+        /// @param fill_factor Fraction of the space of a node used by its cells. The free space
+        /// left in the nodes lets later insertions proceed without splitting them right away.
+        /// @pre fill_factor must be between 0.5 and 1.
+        BulkLoader(pager::Pager& pager, double fill_factor = DEFAULT_FILL_FACTOR);
+
+        /// Add a key/value pair to the tree.
+        /// @throw common::MkvDBException if the key is not greater than the previous key, or if the
+        /// key or the key/value pair is too large (see BTree::max_key_size and
+        /// BTree::max_key_value_size). Large values can be added after the load with BTree::Put.
+        void Add(common::ConstByteSpan key, common::ConstByteSpan value);
+
+        /// Complete the nodes under construction. The last node of each level is balanced with the
+        /// node completed before it, so no node is left almost empty.
+        /// @return The index of the root page of the new tree (see BTree::BTree).
+        pager::Page::PageIndex Finish();
+
+    private:
+        /// Cell of a node under construction.
+        struct PendingCell
+        {
+            /// Offset of the cell in the data of the level.
+            std::size_t offset;
+
+            common::FileOffset key_size;
+            common::FileOffset value_size;
+        };
+
+        /// Node under construction at a level of the tree.
+        struct Level
+        {
+            /// Keys and values of the cells of the node, one after the other.
+            std::vector<std::byte> data;
+
+            std::vector<PendingCell> cells;
+
+            /// Space needed by the cells in the node.
+            common::FileOffset used_size = 0;
+
+            /// Lower fence of the node. The first node of a level has no lower fence.
+            std::optional<std::vector<std::byte>> lower_fence;
+
+            /// Rightmost child of an inner node.
+            std::optional<pager::Page::PageIndex> right_child;
+
+            /// Index of the page of the last node completed at the level, if any.
+            std::optional<pager::Page::PageIndex> previous_index;
+
+            /// Lower fence of the last node completed at the level.
+            std::optional<std::vector<std::byte>> previous_lower_fence;
+
+            /// Returns the key of a cell.
+            common::ConstByteSpan KeyAt(std::size_t pos) const;
+
+            /// Append a cell to the node.
+            void Append(common::ConstByteSpan key, common::ConstByteSpan value);
+        };
+
+        /// Indicate if a cell can be added to a node without going over the fill factor.
+        bool Fits(const Level& level,
+                  common::FileOffset key_size,
+                  common::FileOffset value_size) const;
+
+        /// Add a child to the node under construction at a level of inner nodes.
+        /// @param level_index Index of the level, the leaves are at level 0.
+        /// @param separator Lower fence of the child. Only the first child of a level has none.
+        /// @param child Index of the page of the child.
+        void AddChild(std::size_t level_index,
+                      std::optional<std::vector<std::byte>> separator,
+                      pager::Page::PageIndex child);
+
+        /// Write the node under construction at a level in a new page and clear it.
+        /// @param upper_fence Upper fence of the node. The last node of a level has none.
+        /// @return The index of the page of the node.
+        pager::Page::PageIndex CloseNode(Level& level,
+                                         NodeHeader::NodeType type,
+                                         std::optional<common::ConstByteSpan> upper_fence);
+
+        /// Write the cells of a node under construction in a page.
+        /// @param page Page of the node. Its previous content is replaced.
+        /// @param upper_fence Upper fence of the node. The last node of a level has none.
+        void WriteNode(pager::Page& page,
+                       const Level& level,
+                       NodeHeader::NodeType type,
+                       std::optional<common::ConstByteSpan> upper_fence);
+
+        /// Balance the last node of a level with the node completed before it. The last node is
+        /// only bounded by the end of the keys, so it can be almost empty, or be an inner node
+        /// with a single child. Both nodes are merged in the page of the previous node if their
+        /// cells fit in a node, otherwise their cells are shared evenly between them.
+        /// @return True if the last node was merged in the previous node, which is already a
+        /// child of the parent level.
+        bool BalanceLastNodes(Level& level, NodeHeader::NodeType type);
+
+        pager::Pager& pager_;
+        common::FileOffset fill_size_;
+        common::ValueSize max_key_size_;
+        common::ValueSize max_key_value_size_;
+
+        /// Index of the last leaf completed, linked to the next one.
+        pager::Page::PageIndex last_leaf_;
+
+        /// Nodes under construction, from the leaves to the highest inner level.
+        std::vector<Level> levels_;
+    };
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_BULK_LOADER_HPP_
\ No newline at end of file
@@ -1,46 +1,69 @@
 #ifndef MKVDB_BTREE_CELL_HPP_
 #define MKVDB_BTREE_CELL_HPP_
 
-#include "mkvdb/common/Serialization.hpp"
+#include "mkvdb/common/Field.hpp"
 #include "mkvdb/common/Types.hpp"
 
+#include <bit>
 #include <cassert>
 
 namespace mkvdb::btree
 {
     /// Represents a cell in a B-Tree node. A cell is a structure that contains a key and a value of
     /// arbitrary sizes.
+    ///
+    /// A cell can be flagged as having an overflow. Its value then only holds the information
+    /// needed to find the part of the value stored out of the node (see OverflowReference). The
+    /// flag is stored in the most significant bit of the key size. The sizes are stored in the byte
+    /// order of the file (see pager::Header::Initialize).
     class Cell
     {
     public:
         /// Constructor, creates a cell from a buffer.
+        /// @param byte_order Byte order of the sizes of the cell.
         /// @pre The buffer must have exactly the size required to store the data it contains.
-        inline Cell(common::ByteSpan buffer);
+        inline Cell(common::ByteSpan buffer, std::endian byte_order = std::endian::big);
 
         /// Constructor, creates a new cell in the buffer with the given key and value.
         /// @param buffer Buffer where the cell will be stored.
         /// @param key Key of the cell.
         /// @param value Value of the cell.
+        /// @param has_overflow Indicate if the value of the cell describes an overflow.
+        /// @param byte_order Byte order of the sizes of the cell.
         /// @pre The buffer must have exactly enough space to store the cell.
-        Cell(common::ByteSpan buffer, common::ConstByteSpan key, common::ConstByteSpan value);
+        Cell(common::ByteSpan buffer,
+             common::ConstByteSpan key,
+             common::ConstByteSpan value,
+             bool has_overflow      = false,
+             std::endian byte_order = std::endian::big);
 
         /// Calculate the size required to store a cell with the given key and value sizes.
         static inline common::ValueSize CalculateRequiredSize(common::ValueSize key_size,
                                                               common::ValueSize value_size);
 
+        /// Read the size of the cell stored at the beginning of a buffer.
+        /// @param buffer Buffer starting with a cell. The buffer may extend past the end of the
+        /// cell.
+        /// @param byte_order Byte order of the sizes of the cell.
+        static inline common::ValueSize ReadSize(common::ConstByteSpan buffer,
+                                                 std::endian byte_order = std::endian::big);
+
         /// Get the key of the cell.
         inline common::ConstByteSpan key() const;
 
         /// Get the value of the cell.
         inline common::ConstByteSpan value() const;
 
+        /// Indicate if the value of the cell describes an overflow.
+        inline bool has_overflow() const;
+
     private:
-        static const size_t KEY_SIZE_SIZE   = sizeof(common::ValueSize);
-        static const size_t VALUE_SIZE_SIZE = sizeof(common::ValueSize);
+        static const common::ValueSize OVERFLOW_FLAG = 0x80000000;
+
+        using KeySizeField   = common::Field<0, common::ValueSize>;
+        using ValueSizeField = common::NextField<KeySizeField, common::ValueSize>;
 
-        static const size_t KEY_SIZE_OFFSET   = 0;
-        static const size_t VALUE_SIZE_OFFSET = KEY_SIZE_OFFSET + KEY_SIZE_SIZE;
-        static const size_t KEY_OFFSET        = VALUE_SIZE_OFFSET + VALUE_SIZE_SIZE;
+        static const size_t KEY_OFFSET = ValueSizeField::END;
 
         inline common::ValueSize key_size() const;
         inline void key_size(common::ValueSize key_size);
@@ -48,43 +71,55 @@ namespace mkvdb::btree
         inline void value_size(common::ValueSize value_size);
 
         common::ByteSpan buffer_;
+        std::endian byte_order_;
     };
 
-    Cell::Cell(common::ByteSpan buffer)
-    : buffer_(buffer)
+    Cell::Cell(common::ByteSpan buffer, std::endian byte_order)
+    : buffer_(buffer),
+      byte_order_(byte_order)
     {
-        assert(buffer_.size() >= KEY_SIZE_SIZE + VALUE_SIZE_SIZE);
-        assert(buffer_.size() == KEY_SIZE_SIZE + VALUE_SIZE_SIZE + key_size() + value_size());
+        assert(buffer_.size() >= KEY_OFFSET);
+        assert(buffer_.size() == KEY_OFFSET + key_size() + value_size());
     }
 
     common::ValueSize Cell::key_size() const
     {
-        return common::Deserialize<common::ValueSize>(
-          buffer_.subspan(KEY_SIZE_OFFSET, KEY_SIZE_SIZE));
+        return KeySizeField::Read(buffer_.data(), byte_order_) & ~OVERFLOW_FLAG;
+    }
+
+    bool Cell::has_overflow() const
+    {
+        return (KeySizeField::Read(buffer_.data(), byte_order_) & OVERFLOW_FLAG) != 0;
     }
 
     void Cell::key_size(common::ValueSize key_size)
     {
-        common::Serialize<common::ValueSize>(key_size,
-                                             buffer_.subspan(KEY_SIZE_OFFSET, KEY_SIZE_SIZE));
+        KeySizeField::Write(buffer_.data(), key_size, byte_order_);
     }
 
     common::ValueSize Cell::value_size() const
     {
-        return common::Deserialize<common::ValueSize>(
-          buffer_.subspan(VALUE_SIZE_OFFSET, VALUE_SIZE_SIZE));
+        return ValueSizeField::Read(buffer_.data(), byte_order_);
     }
 
     void Cell::value_size(common::ValueSize value_size)
     {
-        common::Serialize<common::ValueSize>(value_size,
-                                             buffer_.subspan(VALUE_SIZE_OFFSET, VALUE_SIZE_SIZE));
+        ValueSizeField::Write(buffer_.data(), value_size, byte_order_);
     }
 
     common::ValueSize Cell::CalculateRequiredSize(common::ValueSize key_size,
                                                   common::ValueSize value_size)
     {
-        return KEY_SIZE_SIZE + VALUE_SIZE_SIZE + key_size + value_size;
+        return KEY_OFFSET + key_size + value_size;
+    }
+
+    common::ValueSize Cell::ReadSize(common::ConstByteSpan buffer, std::endian byte_order)
+    {
+        assert(buffer.size() >= KEY_OFFSET);
+
+        auto key_size   = KeySizeField::Read(buffer.data(), byte_order) & ~OVERFLOW_FLAG;
+        auto value_size = ValueSizeField::Read(buffer.data(), byte_order);
+        return CalculateRequiredSize(key_size, value_size);
     }
 
     common::ConstByteSpan Cell::key() const
@@ -0,0 +1,107 @@
+#ifndef MKVDB_BTREE_CURSOR_HPP_
+#define MKVDB_BTREE_CURSOR_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+
+#include "KeyValueBatch.hpp"
+#include "NodeHeader.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    class BTree;
+
+    /// Cursor moving over the key/value pairs of a B-tree in the order of the keys.
+    ///
+    /// The cursor keeps the page of its current leaf and moves to the neighbouring leaves by
+    /// following their sibling links, so a scan only descends from the root once. The values
+    /// stored in the leaves are returned without being copied.
+    ///
+    /// A cursor is invalidated by any modification of the tree.
+    class Cursor
+    {
+    public:
+        /// Constructor. The cursor is not positioned until one of the Seek methods is called.
+        /// @param tree The tree to read.
+        explicit Cursor(const BTree& tree);
+
+        /// Indicate if the cursor is positioned on a pair.
+        inline bool is_valid() const { return leaf_ != nullptr; }
+
+        /// Move to the first pair whose key is greater or equal to a key.
+        /// @return False if there is no such pair.
+        bool Seek(common::ConstByteSpan key);
+
+        /// Move to the first pair of the tree.
+        /// @return False if the tree is empty.
+        bool SeekToFirst();
+
+        /// Move to the last pair of the tree.
+        /// @return False if the tree is empty.
+        bool SeekToLast();
+
+        /// Move to the next pair.
+        /// @return False if the cursor was on the last pair. The cursor is then not valid anymore.
+        /// @pre The cursor must be valid.
+        bool Next();
+
+        /// Move to the previous pair.
+        /// @return False if the cursor was on the first pair. The cursor is then not valid
+        /// anymore.
+        /// @pre The cursor must be valid.
+        bool Prev();
+
+        /// Returns the key of the current pair. It is valid until the cursor moves.
+        /// @pre The cursor must be valid.
+        common::ConstByteSpan key() const;
+
+        /// Returns the value of the current pair. It is valid until the cursor moves. A value
+        /// stored in overflow pages is read in a buffer of the cursor, the others are read in
+        /// place.
+        /// @pre The cursor must be valid.
+        common::ConstByteSpan value() const;
+
+        /// Read the pairs from the current position into a batch and move after them. The pairs
+        /// are copied straight from the leaves into the buffers of the batch, one leaf at a time,
+        /// and the next leaf is prefetched while a leaf is copied.
+        /// @param batch Batch receiving the pairs. It is cleared first.
+        /// @param max_rows Maximum number of pairs read.
+        /// @param max_bytes Maximum size of the keys and values read. The first pair is read even
+        /// if it is larger.
+        /// @param end End of the range read. The pairs whose key is greater or equal to end are
+        /// not read and the cursor becomes invalid when it reaches them.
+        /// @return The number of pairs read. The cursor is not valid anymore when the end of the
+        /// range is reached.
+        std::size_t ScanBatch(KeyValueBatch& batch,
+                              std::size_t max_rows,
+                              common::FileOffset max_bytes,
+                              std::optional<common::ConstByteSpan> end = std::nullopt);
+
+    private:
+        /// Move forward to the first existing position, from the current position. Empty leaves
+        /// are skipped.
+        bool SettleForward();
+
+        /// Move backward to the position before the current position. Empty leaves are skipped.
+        bool MoveBackward();
+
+        /// Update the key of the current pair.
+        void LoadKey();
+
+        const BTree& tree_;
+        std::shared_ptr<pager::Page> leaf_;
+        NodeHeader::NodeSize position_;
+        std::vector<std::byte> key_;
+
+        /// Buffer receiving the values stored in overflow pages.
+        mutable std::vector<std::byte> overflow_value_;
+    };
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_CURSOR_HPP_
\ No newline at end of file
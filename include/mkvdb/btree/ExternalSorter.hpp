@@ -0,0 +1,183 @@
+#ifndef MKVDB_BTREE_EXTERNAL_SORTER_HPP_
+#define MKVDB_BTREE_EXTERNAL_SORTER_HPP_
+
+#include "mkvdb/common/ThreadPool.hpp"
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/fs/IFile.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    /// Sorter of key/value pairs too large to be sorted in memory, typically to feed a BulkLoader.
+    ///
+    /// The pairs added are gathered in runs of a bounded size. Each full run is sorted and spilled
+    /// to a temporary file by a pool of threads while the next run is filled. The last run stays in
+    /// memory. The runs are then merged with a loser tree into a single sorted stream, reading each
+    /// spilled run sequentially.
+    ///
+    /// Pairs with equal keys are all returned, in the order they were added.
+    class ExternalSorter
+    {
+    public:
+        /// Function creating a new temporary file for a run. The file is created, written, read
+        /// and deleted by the sorter.
+        using FileFactory = std::function<std::unique_ptr<fs::IFile>()>;
+
+        /// Default size of a run.
+        static constexpr std::size_t DEFAULT_RUN_SIZE = 64 * 1024 * 1024;
+
+        /// Default number of threads sorting the runs.
+        static constexpr std::size_t DEFAULT_THREADS_COUNT = 2;
+
+        /// Constructor.
+        /// @param create_file Function creating the temporary files.
+        /// @param run_size Memory used by a run. Up to threads_count + 1 runs are in memory at the
+        /// same time, one being filled and the others being sorted and spilled.
+        /// @param threads_count Number of threads sorting the runs. Must be greater than zero.
+        ExternalSorter(FileFactory create_file,
+                       std::size_t run_size      = DEFAULT_RUN_SIZE,
+                       std::size_t threads_count = DEFAULT_THREADS_COUNT);
+
+        /// Destructor. The temporary files are deleted.
+        ~ExternalSorter();
+
+        ExternalSorter(const ExternalSorter&)            = delete;
+        ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+        /// Add a key/value pair.
+        /// @pre Finish must not have been called.
+        /// @throw common::MkvDBException if the key or the value is 4 GiB or larger.
+        void Add(common::ConstByteSpan key, common::ConstByteSpan value);
+
+        /// Complete the runs and prepare their merge. No more pairs can be added.
+        /// @throw common::MkvDBException or the exception of the file if a run could not be
+        /// spilled.
+        void Finish();
+
+        /// Move to the next pair in the order of the keys. The first call moves to the first pair.
+        /// @return False when there is no more pair.
+        /// @pre Finish must have been called.
+        bool Next();
+
+        /// Returns the key of the current pair. It is valid until the next call to Next.
+        common::ConstByteSpan key() const;
+
+        /// Returns the value of the current pair. It is valid until the next call to Next.
+        common::ConstByteSpan value() const;
+
+        /// Returns the number of runs spilled to temporary files.
+        inline std::size_t spilled_runs_count() const { return files_.size(); }
+
+    private:
+        /// Size of the sizes of the key and the value stored before each pair in a run.
+        static constexpr std::size_t RECORD_HEADER_SIZE = 2 * sizeof(common::ValueSize);
+
+        /// Size of the blocks written when a run is spilled.
+        static constexpr std::size_t WRITE_BLOCK_SIZE = 1024 * 1024;
+
+        /// Minimum size of the blocks read from a run during the merge.
+        static constexpr std::size_t MIN_READ_BLOCK_SIZE = 64 * 1024;
+
+        /// Pairs of a run, stored as records: the size of the key, the size of the value, the key
+        /// and the value.
+        struct Run
+        {
+            std::vector<std::byte> records;
+
+            /// Offsets of the records, sorted by SortRun.
+            std::vector<std::size_t> offsets;
+        };
+
+        /// Sequential reader of the records of a sorted run, in memory or in a file.
+        class RunReader
+        {
+        public:
+            /// Constructor of a reader of a spilled run.
+            /// @param block_size Size of the blocks read from the file.
+            RunReader(fs::IFile& file, std::size_t block_size);
+
+            /// Constructor of a reader of a run in memory.
+            /// @param records The records of the run in their order.
+            RunReader(std::vector<std::byte> records);
+
+            /// Move to the next record.
+            /// @return False at the end of the run.
+            bool Next();
+
+            /// Indicate if the end of the run is reached.
+            inline bool is_exhausted() const { return is_exhausted_; }
+
+            inline common::ConstByteSpan key() const { return key_; }
+            inline common::ConstByteSpan value() const { return value_; }
+
+        private:
+            /// Make sure that a number of bytes after the current record are in the buffer.
+            /// @return False if the run has fewer bytes left.
+            bool Fill(std::size_t size);
+
+            fs::IFile* file_;
+            common::FileOffset file_offset_;
+            std::vector<std::byte> buffer_;
+
+            /// Start and end of the bytes of the buffer not read yet.
+            std::size_t begin_;
+            std::size_t end_;
+
+            /// Size of the current record, at the start of the bytes not read yet.
+            std::size_t record_size_;
+
+            common::ConstByteSpan key_;
+            common::ConstByteSpan value_;
+            bool is_exhausted_;
+        };
+
+        /// Sort the offsets of the records of a run by key, keeping the order of equal keys.
+        static void SortRun(Run& run);
+
+        /// Write the records of a sorted run in a file.
+        static void WriteRun(const Run& run, fs::IFile& file);
+
+        /// Start sorting and spilling the current run and start a new one.
+        void SpillRun();
+
+        /// Wait for the oldest run being spilled.
+        void WaitForSpill();
+
+        /// Indicate if the current record of a reader goes before the current record of another
+        /// reader. Exhausted readers go after all the others.
+        bool IsBefore(std::size_t lhs, std::size_t rhs) const;
+
+        /// Play the matches of a subtree of the loser tree.
+        /// @param node Index of the root of the subtree.
+        /// @return The index of the reader winning the subtree.
+        std::size_t BuildLoserTree(std::size_t node);
+
+        FileFactory create_file_;
+        std::size_t run_size_;
+        std::size_t threads_count_;
+        common::ThreadPool threads_;
+
+        Run run_;
+        std::vector<std::unique_ptr<fs::IFile>> files_;
+        std::deque<std::future<void>> spills_;
+
+        bool is_finished_;
+        bool is_started_;
+        std::vector<RunReader> readers_;
+
+        /// Loser tree over the readers. The node i has the children 2i and 2i + 1, the leaves
+        /// are the nodes readers_.size() to 2 * readers_.size() - 1 and losers_[i] is the loser
+        /// of the match played at node i.
+        std::vector<std::size_t> losers_;
+        std::size_t winner_;
+    };
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_EXTERNAL_SORTER_HPP_
\ No newline at end of file
@@ -0,0 +1,316 @@
+#ifndef MKVDB_BTREE_FIXED_BTREE_HPP_
+#define MKVDB_BTREE_FIXED_BTREE_HPP_
+
+#include "mkvdb/common/MkvDBException.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "FixedNode.hpp"
+#include "NodeHeader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    /// B+tree mapping unsigned integer keys to unsigned integer values, stored in FixedNode pages.
+    ///
+    /// The layout of the nodes is chosen when the tree is created: a tree created by
+    /// FixedBTree<KeyT, ValueT>::Create must always be opened with the same KeyT and ValueT. Like
+    /// BTree, the root always stays on the same page. A full leaf is split in two halves, except
+    /// the rightmost leaf when a key is appended after its last key: the new leaf then starts with
+    /// the new key, so the leaves filled by increasing keys stay full. The nodes are not merged
+    /// when keys are deleted.
+    template<typename KeyT, typename ValueT>
+    class FixedBTree
+    {
+    public:
+        using FixedNodeType = FixedNode<KeyT, ValueT>;
+
+        /// Create a new empty tree.
+        /// @param pager Pager where the tree is created.
+        /// @return The index of the root page of the new tree.
+        static inline pager::Page::PageIndex Create(pager::Pager& pager);
+
+        /// Constructor. Open an existing tree.
+        /// @param pager Pager containing the tree.
+        /// @param root_index Index of the root page of the tree.
+        /// @throw common::MkvDBException if the page is not the root of a fixed-size tree, or if
+        /// the tree was created with keys or values of other sizes.
+        inline FixedBTree(pager::Pager& pager, pager::Page::PageIndex root_index);
+
+        /// Returns the index of the root page of the tree.
+        inline pager::Page::PageIndex root_index() const { return root_index_; }
+
+        /// Returns the height of the tree. A tree with a single leaf node has a height of 1.
+        inline std::size_t height() const;
+
+        /// Get the value associated with a key.
+        /// @return The value or std::nullopt if the key is not in the tree.
+        inline std::optional<ValueT> Get(KeyT key) const;
+
+        /// Insert a key/value pair in the tree. If the key is already in the tree its value is
+        /// replaced.
+        inline void Put(KeyT key, ValueT value);
+
+        /// Delete a key and its value from the tree.
+        /// @return True if the key was in the tree, false otherwise.
+        inline bool Delete(KeyT key);
+
+    private:
+        /// Entry of the path followed from the root to a leaf.
+        struct PathEntry
+        {
+            /// Page of an inner node.
+            std::shared_ptr<pager::Page> page;
+
+            /// Position of the child followed in the node.
+            NodeHeader::NodeSize position;
+        };
+
+        /// Descend from the root to the leaf that may contain a key.
+        /// @param path If not nullptr, receives the inner nodes traversed.
+        inline std::shared_ptr<pager::Page> FindLeaf(KeyT key, std::vector<PathEntry>* path) const;
+
+        /// Move the content of the root node to a new child, making the root an inner node with a
+        /// single child.
+        /// @return The page of the new child.
+        inline std::shared_ptr<pager::Page> GrowRoot(pager::Page& root);
+
+        /// Insert a separator and the new child that follows it in the parents of a split node,
+        /// splitting the parents that are full.
+        /// @param path Inner nodes traversed from the root to the split node.
+        inline void InsertSeparator(std::vector<PathEntry>& path,
+                                    KeyT separator,
+                                    pager::Page::PageIndex child);
+
+        pager::Pager& pager_;
+        pager::Page::PageIndex root_index_;
+    };
+
+    template<typename KeyT, typename ValueT>
+    pager::Page::PageIndex FixedBTree<KeyT, ValueT>::Create(pager::Pager& pager)
+    {
+        auto page = pager.GetNewPage();
+        FixedNodeType(*page).InitializeNewNode(NodeHeader::NodeType::FixedLeaf);
+        return page->index();
+    }
+
+    template<typename KeyT, typename ValueT>
+    FixedBTree<KeyT, ValueT>::FixedBTree(pager::Pager& pager, pager::Page::PageIndex root_index)
+    : pager_(pager),
+      root_index_(root_index)
+    {
+        auto root = pager_.GetPage(root_index_);
+        auto type =
+          NodeHeader(root->content().subspan(0, NodeHeader::HEADER_SIZE), root->byte_order())
+            .type();
+        if(type != NodeHeader::NodeType::FixedLeaf && type != NodeHeader::NodeType::FixedInner)
+        {
+            throw common::MkvDBException("The page is not the root of a fixed-size B-tree.");
+        }
+
+        FixedNodeType node(*root);
+        if(node.stored_key_size() != sizeof(KeyT) || node.stored_value_size() != sizeof(ValueT))
+        {
+            throw common::MkvDBException(
+              "The fixed-size B-tree was created with keys or values of other sizes.");
+        }
+    }
+
+    template<typename KeyT, typename ValueT>
+    std::size_t FixedBTree<KeyT, ValueT>::height() const
+    {
+        std::size_t height = 1;
+
+        auto page = pager_.GetPage(root_index_);
+        while(!FixedNodeType(*page).is_leaf())
+        {
+            page = pager_.GetPage(FixedNodeType(*page).ChildAt(0));
+            ++height;
+        }
+
+        return height;
+    }
+
+    template<typename KeyT, typename ValueT>
+    std::optional<ValueT> FixedBTree<KeyT, ValueT>::Get(KeyT key) const
+    {
+        auto page = FindLeaf(key, nullptr);
+        FixedNodeType leaf(*page);
+
+        auto pos = leaf.LowerBound(key);
+        if(pos == leaf.size() || leaf.KeyAt(pos) != key)
+        {
+            return std::nullopt;
+        }
+        return leaf.ValueAt(pos);
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedBTree<KeyT, ValueT>::Put(KeyT key, ValueT value)
+    {
+        std::vector<PathEntry> path;
+        auto page = FindLeaf(key, &path);
+        FixedNodeType leaf(*page);
+
+        auto pos = leaf.LowerBound(key);
+        if(pos < leaf.size() && leaf.KeyAt(pos) == key)
+        {
+            leaf.SetValueAt(pos, value);
+            return;
+        }
+        if(!leaf.is_full())
+        {
+            leaf.Insert(pos, key, value);
+            return;
+        }
+
+        if(path.empty())
+        {
+            auto child = GrowRoot(*page);
+            path.push_back({ std::move(page), 0 });
+            page = std::move(child);
+        }
+
+        // A key appended after the last key of the rightmost leaf starts a new leaf. Otherwise
+        // the upper half of the keys moves to the new leaf.
+        FixedNodeType node(*page);
+        auto right_page = pager_.GetNewPage();
+        FixedNodeType right(*right_page);
+        right.InitializeNewNode(NodeHeader::NodeType::FixedLeaf);
+
+        bool is_append = pos == node.size() && node.right_sibling() == 0;
+        NodeHeader::NodeSize middle = is_append ? node.size() : node.size() / 2;
+        if(middle < node.size())
+        {
+            node.MoveTail(middle, right);
+        }
+        if(pos < middle || (pos == middle && !is_append))
+        {
+            node.Insert(pos, key, value);
+        }
+        else
+        {
+            right.Insert(pos - middle, key, value);
+        }
+
+        // The new leaf is linked between the node and its former right sibling.
+        right.SetLeftSibling(page->index());
+        right.SetRightSibling(node.right_sibling());
+        if(node.right_sibling() != 0)
+        {
+            FixedNodeType next(*pager_.GetPage(node.right_sibling()));
+            next.SetLeftSibling(right_page->index());
+        }
+        node.SetRightSibling(right_page->index());
+
+        InsertSeparator(path, right.KeyAt(0), right_page->index());
+    }
+
+    template<typename KeyT, typename ValueT>
+    bool FixedBTree<KeyT, ValueT>::Delete(KeyT key)
+    {
+        auto page = FindLeaf(key, nullptr);
+        FixedNodeType leaf(*page);
+
+        auto pos = leaf.LowerBound(key);
+        if(pos == leaf.size() || leaf.KeyAt(pos) != key)
+        {
+            return false;
+        }
+
+        leaf.Erase(pos);
+        return true;
+    }
+
+    template<typename KeyT, typename ValueT>
+    std::shared_ptr<pager::Page> FixedBTree<KeyT, ValueT>::FindLeaf(
+      KeyT key, std::vector<PathEntry>* path) const
+    {
+        auto page = pager_.GetPage(root_index_);
+        for(;;)
+        {
+            FixedNodeType node(*page);
+            if(node.is_leaf())
+            {
+                return page;
+            }
+
+            auto position = node.FindChildPosition(key);
+            if(path)
+            {
+                path->push_back({ page, position });
+            }
+            page = pager_.GetPage(node.ChildAt(position));
+        }
+    }
+
+    template<typename KeyT, typename ValueT>
+    std::shared_ptr<pager::Page> FixedBTree<KeyT, ValueT>::GrowRoot(pager::Page& root)
+    {
+        auto child   = pager_.GetNewPage();
+        auto content = root.content();
+        std::copy(content.begin(), content.end(), child->content().begin());
+        child->MarkAsModified();
+
+        FixedNodeType node(root);
+        node.InitializeNewNode(NodeHeader::NodeType::FixedInner);
+        node.SetChildAt(0, child->index());
+
+        return child;
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedBTree<KeyT, ValueT>::InsertSeparator(std::vector<PathEntry>& path,
+                                                   KeyT separator,
+                                                   pager::Page::PageIndex child)
+    {
+        for(;;)
+        {
+            auto parent = std::move(path.back());
+            path.pop_back();
+            if(!FixedNodeType(*parent.page).is_full())
+            {
+                FixedNodeType(*parent.page).InsertChild(parent.position, separator, child);
+                return;
+            }
+
+            if(path.empty())
+            {
+                auto new_child = GrowRoot(*parent.page);
+                path.push_back({ std::move(parent.page), 0 });
+                parent.page = std::move(new_child);
+            }
+
+            // The key at the middle moves up to the grandparent. When the new child is the last
+            // one, only the last key and child move to the new node, as for the leaves.
+            FixedNodeType node(*parent.page);
+            auto right_page = pager_.GetNewPage();
+            FixedNodeType right(*right_page);
+            right.InitializeNewNode(NodeHeader::NodeType::FixedInner);
+
+            auto pos = parent.position;
+            NodeHeader::NodeSize middle = pos == node.size() ? node.size() - 1 : node.size() / 2;
+            auto pushed                 = node.KeyAt(middle);
+            node.MoveTail(middle, right);
+            if(pos <= middle)
+            {
+                node.InsertChild(pos, separator, child);
+            }
+            else
+            {
+                right.InsertChild(pos - middle - 1, separator, child);
+            }
+
+            separator = pushed;
+            child     = right_page->index();
+        }
+    }
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_FIXED_BTREE_HPP_
\ No newline at end of file
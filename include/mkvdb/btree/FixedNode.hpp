@@ -0,0 +1,389 @@
+#ifndef MKVDB_BTREE_FIXED_NODE_HPP_
+#define MKVDB_BTREE_FIXED_NODE_HPP_
+
+#include "mkvdb/common/Serialization.hpp"
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+
+#include "NodeHeader.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace mkvdb::btree
+{
+    /// B-tree node whose keys and values are unsigned integers of fixed sizes.
+    ///
+    /// The node uses the same header as Node, followed by two dense arrays, without slots and
+    /// without size headers:
+    ///
+    ///   | NodeHeader | keys (capacity * sizeof(KeyT)) | values (capacity * sizeof(ValueT)) |
+    ///
+    /// An inner node stores child page indexes instead of values, with one more child than keys.
+    /// The child at position i contains the keys smaller than the key at position i, and the last
+    /// child contains the keys greater or equal to the last key. The keys, values and children are
+    /// stored in big-endian order. The header is stored in the byte order of the file, like the
+    /// headers of the other nodes.
+    ///
+    /// The byte size and the unallocated space of the header are not used by a fixed node. They
+    /// hold the sizes of the keys and of the values, so a node is not read with the wrong layout.
+    template<typename KeyT, typename ValueT>
+    class FixedNode
+    {
+    public:
+        static_assert(std::is_integral_v<KeyT> && std::is_unsigned_v<KeyT>);
+        static_assert(std::is_integral_v<ValueT> && std::is_unsigned_v<ValueT>);
+
+        /// Constructor.
+        /// @param page Page containing the node.
+        inline FixedNode(pager::Page& page);
+
+        /// Initialize a new empty node in the page.
+        inline void InitializeNewNode(NodeHeader::NodeType type = NodeHeader::NodeType::FixedLeaf);
+
+        /// Returns the page of the node.
+        inline pager::Page& page() const { return page_; }
+
+        /// Indicate if the node is a leaf.
+        inline bool is_leaf() const { return header_.type() == NodeHeader::NodeType::FixedLeaf; }
+
+        /// Returns the number of keys in the node.
+        inline NodeHeader::NodeSize size() const { return header_.size(); }
+
+        /// Returns the maximum number of keys of the node.
+        inline NodeHeader::NodeSize capacity() const { return capacity_; }
+
+        /// Returns the size of the keys the node was initialized with.
+        inline std::size_t stored_key_size() const { return header_.byte_size(); }
+
+        /// Returns the size of the values the node was initialized with.
+        inline std::size_t stored_value_size() const { return header_.unallocated_space(); }
+
+        /// Indicate if the node has no room for another key.
+        inline bool is_full() const { return size() == capacity_; }
+
+        /// Returns the key at a given position.
+        /// @pre pos must be less than the size of the node.
+        inline KeyT KeyAt(NodeHeader::NodeSize pos) const;
+
+        /// Returns the value at a given position of a leaf.
+        /// @pre pos must be less than the size of the node.
+        inline ValueT ValueAt(NodeHeader::NodeSize pos) const;
+
+        /// Returns the child at a given position of an inner node.
+        /// @pre pos must be less or equal to the size of the node.
+        inline pager::Page::PageIndex ChildAt(NodeHeader::NodeSize pos) const;
+
+        /// Returns the position of the first key greater or equal to a key.
+        inline NodeHeader::NodeSize LowerBound(KeyT key) const;
+
+        /// Returns the position of the child of an inner node that may contain a key.
+        inline NodeHeader::NodeSize FindChildPosition(KeyT key) const;
+
+        /// Insert a key/value pair in a leaf.
+        /// @pre The node must not be full and inserting at pos must keep the keys sorted.
+        inline void Insert(NodeHeader::NodeSize pos, KeyT key, ValueT value);
+
+        /// Insert a key in an inner node, followed by the child containing the keys greater or
+        /// equal to it.
+        /// @pre The node must not be full and inserting at pos must keep the keys sorted.
+        inline void InsertChild(NodeHeader::NodeSize pos, KeyT key, pager::Page::PageIndex child);
+
+        /// Overwrite the value at a given position of a leaf.
+        /// @pre pos must be less than the size of the node.
+        inline void SetValueAt(NodeHeader::NodeSize pos, ValueT value);
+
+        /// Overwrite the child at a given position of an inner node.
+        /// @pre pos must be less or equal to the size of the node.
+        inline void SetChildAt(NodeHeader::NodeSize pos, pager::Page::PageIndex child);
+
+        /// Erase the key/value pair at a given position of a leaf.
+        /// @pre pos must be less than the size of the node.
+        inline void Erase(NodeHeader::NodeSize pos);
+
+        /// Move the keys from a position to the end of the node to an empty node of the same
+        /// type. In an inner node, the key at the position is removed instead of being moved: it
+        /// separates the two nodes. The children that follow it are moved.
+        /// @pre pos must be less than the size of the node.
+        inline void MoveTail(NodeHeader::NodeSize pos, FixedNode& destination);
+
+        /// Returns the index of the previous leaf, or 0 if the node is the first leaf.
+        inline pager::Page::PageIndex left_sibling() const { return header_.left_sibling(); }
+
+        /// Returns the index of the next leaf, or 0 if the node is the last leaf.
+        inline pager::Page::PageIndex right_sibling() const { return header_.right_sibling(); }
+
+        /// Set the index of the previous leaf.
+        inline void SetLeftSibling(pager::Page::PageIndex index);
+
+        /// Set the index of the next leaf.
+        inline void SetRightSibling(pager::Page::PageIndex index);
+
+        /// Returns the maximum number of keys of a node.
+        /// @param content_size Size of the content of the pages.
+        /// @param type Type of the node.
+        static inline NodeHeader::NodeSize Capacity(common::FileOffset content_size,
+                                                    NodeHeader::NodeType type);
+
+    private:
+        /// Size of the elements stored after the keys: the values or the children.
+        inline std::size_t element_size() const
+        {
+            return is_leaf() ? sizeof(ValueT) : sizeof(pager::Page::PageIndex);
+        }
+
+        /// Returns the offset of the key at a position.
+        inline std::size_t key_offset(std::size_t pos) const
+        {
+            return NodeHeader::HEADER_SIZE + pos * sizeof(KeyT);
+        }
+
+        /// Returns the offset of the value or the child at a position.
+        inline std::size_t element_offset(std::size_t pos) const
+        {
+            return key_offset(capacity_) + pos * element_size();
+        }
+
+        /// Shift the elements from a position to the end of an array by one element toward the
+        /// end of the array.
+        inline void ShiftRight(std::size_t offset, std::size_t count, std::size_t element_size);
+
+        pager::Page& page_;
+        NodeHeader header_;
+        NodeHeader::NodeSize capacity_;
+    };
+
+    template<typename KeyT, typename ValueT>
+    FixedNode<KeyT, ValueT>::FixedNode(pager::Page& page)
+    : page_(page),
+      header_(page.content().subspan(0, NodeHeader::HEADER_SIZE), page.byte_order()),
+      capacity_(Capacity(page.content().size(), header_.type()))
+    {
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::InitializeNewNode(NodeHeader::NodeType type)
+    {
+        assert(type == NodeHeader::NodeType::FixedLeaf || type == NodeHeader::NodeType::FixedInner);
+
+        header_.size(0);
+        header_.byte_size(sizeof(KeyT));
+        header_.unallocated_space(sizeof(ValueT));
+        header_.type(type);
+        header_.right_child(0);
+        header_.prefix_size(0);
+        header_.left_sibling(0);
+        header_.right_sibling(0);
+        capacity_ = Capacity(page_.content().size(), type);
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    KeyT FixedNode<KeyT, ValueT>::KeyAt(NodeHeader::NodeSize pos) const
+    {
+        assert(pos < size());
+        return common::Deserialize<KeyT>(page_.content().subspan(key_offset(pos), sizeof(KeyT)));
+    }
+
+    template<typename KeyT, typename ValueT>
+    ValueT FixedNode<KeyT, ValueT>::ValueAt(NodeHeader::NodeSize pos) const
+    {
+        assert(is_leaf());
+        assert(pos < size());
+        return common::Deserialize<ValueT>(
+          page_.content().subspan(element_offset(pos), sizeof(ValueT)));
+    }
+
+    template<typename KeyT, typename ValueT>
+    pager::Page::PageIndex FixedNode<KeyT, ValueT>::ChildAt(NodeHeader::NodeSize pos) const
+    {
+        assert(!is_leaf());
+        assert(pos <= size());
+        return common::Deserialize<pager::Page::PageIndex>(
+          page_.content().subspan(element_offset(pos), sizeof(pager::Page::PageIndex)));
+    }
+
+    template<typename KeyT, typename ValueT>
+    NodeHeader::NodeSize FixedNode<KeyT, ValueT>::LowerBound(KeyT key) const
+    {
+        // Branchless binary search: the range is halved with a conditional move instead of a
+        // branch, so the search doesn't stall on mispredicted comparisons.
+        NodeHeader::NodeSize count = size();
+        if(count == 0)
+        {
+            return 0;
+        }
+
+        NodeHeader::NodeSize base = 0;
+        while(count > 1)
+        {
+            NodeHeader::NodeSize half = count / 2;
+            base                      = KeyAt(base + half) < key ? base + half : base;
+            count -= half;
+        }
+        return base + (KeyAt(base) < key ? 1 : 0);
+    }
+
+    template<typename KeyT, typename ValueT>
+    NodeHeader::NodeSize FixedNode<KeyT, ValueT>::FindChildPosition(KeyT key) const
+    {
+        auto pos = LowerBound(key);
+        return pos < size() && KeyAt(pos) == key ? pos + 1 : pos;
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::Insert(NodeHeader::NodeSize pos, KeyT key, ValueT value)
+    {
+        assert(is_leaf());
+        assert(pos <= size());
+        assert(!is_full());
+
+        auto content = page_.content();
+        ShiftRight(key_offset(pos), size() - pos, sizeof(KeyT));
+        ShiftRight(element_offset(pos), size() - pos, sizeof(ValueT));
+        common::Serialize(key, content.subspan(key_offset(pos), sizeof(KeyT)));
+        common::Serialize(value, content.subspan(element_offset(pos), sizeof(ValueT)));
+        header_.size(size() + 1);
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::InsertChild(NodeHeader::NodeSize pos,
+                                              KeyT key,
+                                              pager::Page::PageIndex child)
+    {
+        assert(!is_leaf());
+        assert(pos <= size());
+        assert(!is_full());
+
+        auto content = page_.content();
+        ShiftRight(key_offset(pos), size() - pos, sizeof(KeyT));
+        ShiftRight(element_offset(pos + 1), size() - pos, sizeof(pager::Page::PageIndex));
+        common::Serialize(key, content.subspan(key_offset(pos), sizeof(KeyT)));
+        common::Serialize(child,
+                          content.subspan(element_offset(pos + 1), sizeof(pager::Page::PageIndex)));
+        header_.size(size() + 1);
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::SetValueAt(NodeHeader::NodeSize pos, ValueT value)
+    {
+        assert(is_leaf());
+        assert(pos < size());
+
+        common::Serialize(value, page_.content().subspan(element_offset(pos), sizeof(ValueT)));
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::SetChildAt(NodeHeader::NodeSize pos,
+                                             pager::Page::PageIndex child)
+    {
+        assert(!is_leaf());
+        assert(pos <= size());
+
+        common::Serialize(
+          child, page_.content().subspan(element_offset(pos), sizeof(pager::Page::PageIndex)));
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::Erase(NodeHeader::NodeSize pos)
+    {
+        assert(is_leaf());
+        assert(pos < size());
+
+        auto data  = page_.content().data();
+        auto count = size() - pos - 1;
+        std::memmove(data + key_offset(pos), data + key_offset(pos + 1), count * sizeof(KeyT));
+        std::memmove(
+          data + element_offset(pos), data + element_offset(pos + 1), count * sizeof(ValueT));
+        header_.size(size() - 1);
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::MoveTail(NodeHeader::NodeSize pos, FixedNode& destination)
+    {
+        assert(pos < size());
+        assert(destination.size() == 0);
+        assert(destination.is_leaf() == is_leaf());
+
+        auto source = page_.content().data();
+        auto target = destination.page_.content().data();
+        if(is_leaf())
+        {
+            auto count = size() - pos;
+            std::memcpy(target + destination.key_offset(0),
+                        source + key_offset(pos),
+                        count * sizeof(KeyT));
+            std::memcpy(target + destination.element_offset(0),
+                        source + element_offset(pos),
+                        count * sizeof(ValueT));
+            destination.header_.size(static_cast<NodeHeader::NodeSize>(count));
+        }
+        else
+        {
+            auto count = size() - pos - 1;
+            std::memcpy(target + destination.key_offset(0),
+                        source + key_offset(pos + 1),
+                        count * sizeof(KeyT));
+            std::memcpy(target + destination.element_offset(0),
+                        source + element_offset(pos + 1),
+                        (count + 1) * sizeof(pager::Page::PageIndex));
+            destination.header_.size(static_cast<NodeHeader::NodeSize>(count));
+        }
+
+        header_.size(pos);
+        page_.MarkAsModified();
+        destination.page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::SetLeftSibling(pager::Page::PageIndex index)
+    {
+        assert(is_leaf());
+
+        header_.left_sibling(index);
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::SetRightSibling(pager::Page::PageIndex index)
+    {
+        assert(is_leaf());
+
+        header_.right_sibling(index);
+        page_.MarkAsModified();
+    }
+
+    template<typename KeyT, typename ValueT>
+    NodeHeader::NodeSize FixedNode<KeyT, ValueT>::Capacity(common::FileOffset content_size,
+                                                           NodeHeader::NodeType type)
+    {
+        // An inner node has room for one more child than keys.
+        auto space = content_size - NodeHeader::HEADER_SIZE;
+        if(type == NodeHeader::NodeType::FixedInner)
+        {
+            constexpr auto entry_size = sizeof(KeyT) + sizeof(pager::Page::PageIndex);
+            return static_cast<NodeHeader::NodeSize>((space - sizeof(pager::Page::PageIndex))
+                                                     / entry_size);
+        }
+        return static_cast<NodeHeader::NodeSize>(space / (sizeof(KeyT) + sizeof(ValueT)));
+    }
+
+    template<typename KeyT, typename ValueT>
+    void FixedNode<KeyT, ValueT>::ShiftRight(std::size_t offset,
+                                             std::size_t count,
+                                             std::size_t element_size)
+    {
+        auto data = page_.content().data() + offset;
+        std::memmove(data + element_size, data, count * element_size);
+    }
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_FIXED_NODE_HPP_
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef MKVDB_BTREE_HEAD_SEARCH_HPP_
+#define MKVDB_BTREE_HEAD_SEARCH_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mkvdb::btree
+{
+    /// Size of a key head in bytes.
+    inline constexpr std::size_t HEAD_SIZE = 4;
+
+    /// Returns the head of a key. The head is the value of the first HEAD_SIZE bytes of the key
+    /// read as a big-endian integer, padded with zeros if the key is shorter. The heads preserve
+    /// the order of the keys: if a key is smaller than another key, its head is smaller or equal.
+    std::uint32_t MakeHead(common::ConstByteSpan key);
+
+    /// Count the heads smaller than a value in a sorted array of heads. This is the position of
+    /// the first head greater or equal to the value.
+    ///
+    /// The array is scanned with SSE2 or AVX2 compares when they are available at compile time and
+    /// with a scalar loop otherwise.
+    /// @param heads Array of heads stored in big-endian order, HEAD_SIZE bytes per head.
+    /// @param count Number of heads in the array.
+    /// @param head Value compared to the heads.
+    std::size_t CountHeadsLessThan(const std::byte* heads, std::size_t count, std::uint32_t head);
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_HEAD_SEARCH_HPP_
\ No newline at end of file
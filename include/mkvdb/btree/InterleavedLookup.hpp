@@ -0,0 +1,52 @@
+#ifndef MKVDB_BTREE_INTERLEAVED_LOOKUP_HPP_
+#define MKVDB_BTREE_INTERLEAVED_LOOKUP_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    class BTree;
+
+    /// Engine running many point lookups of a B-tree on a single thread.
+    ///
+    /// Each lookup is a coroutine that starts loading the next node of its descent, either with a
+    /// pager prefetch for the page or with a CPU prefetch for the parts of the node it searches,
+    /// and then suspends. The engine resumes the other lookups of its group in the meantime, so
+    /// the cache misses and the page reads of a group overlap instead of stalling one after the
+    /// other.
+    class InterleavedLookup
+    {
+    public:
+        /// Default number of lookups in flight.
+        static constexpr std::size_t DEFAULT_GROUP_SIZE = 16;
+
+        /// Constructor.
+        /// @param tree The tree to read.
+        /// @param group_size Number of lookups in flight. Must be greater than 0.
+        explicit InterleavedLookup(const BTree& tree, std::size_t group_size = DEFAULT_GROUP_SIZE);
+
+        /// Get the values associated with many keys.
+        /// @return The values, in the order of the keys. A value is std::nullopt if its key is not
+        /// in the tree.
+        std::vector<std::optional<std::vector<std::byte>>>
+          Get(std::span<const common::ConstByteSpan> keys) const;
+
+    private:
+        /// Coroutine of a single lookup.
+        class Task;
+
+        /// Look up a key in the tree, suspending before each access that may miss.
+        /// @param value Receives the value if the key is in the tree.
+        Task Lookup(common::ConstByteSpan key, std::optional<std::vector<std::byte>>& value) const;
+
+        const BTree& tree_;
+        std::size_t group_size_;
+    };
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_INTERLEAVED_LOOKUP_HPP_
\ No newline at end of file
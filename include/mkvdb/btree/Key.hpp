@@ -0,0 +1,49 @@
+#ifndef MKVDB_BTREE_KEY_HPP_
+#define MKVDB_BTREE_KEY_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mkvdb::btree
+{
+    /// Compare two keys. The keys are ordered by the lexicographical order of their bytes, as
+    /// unsigned values. A key that is a prefix of another key is smaller than the other key.
+    /// @return A negative value if lhs is smaller than rhs, zero if they are equal and a positive
+    /// value if lhs is greater than rhs.
+    inline int CompareKeys(common::ConstByteSpan lhs, common::ConstByteSpan rhs)
+    {
+        auto common_size = std::min(lhs.size(), rhs.size());
+        if(common_size > 0)
+        {
+            int result = std::memcmp(lhs.data(), rhs.data(), common_size);
+            if(result != 0)
+            {
+                return result;
+            }
+        }
+
+        return lhs.size() < rhs.size() ? -1 : (lhs.size() > rhs.size() ? 1 : 0);
+    }
+
+    /// Returns the size of the longest prefix shared by two keys.
+    inline std::size_t CommonPrefixSize(common::ConstByteSpan lhs, common::ConstByteSpan rhs)
+    {
+        auto common_size = std::min(lhs.size(), rhs.size());
+        auto mismatch    = std::mismatch(lhs.begin(), lhs.begin() + common_size, rhs.begin());
+        return static_cast<std::size_t>(mismatch.first - lhs.begin());
+    }
+
+    /// Returns the size of the shortest prefix of rhs that is greater than lhs. This prefix
+    /// separates the two keys: it is greater than lhs and smaller or equal to rhs.
+    /// @pre lhs must be smaller than rhs.
+    inline std::size_t ShortestSeparatorSize(common::ConstByteSpan lhs, common::ConstByteSpan rhs)
+    {
+        assert(CompareKeys(lhs, rhs) < 0);
+        return CommonPrefixSize(lhs, rhs) + 1;
+    }
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_KEY_HPP_
\ No newline at end of file
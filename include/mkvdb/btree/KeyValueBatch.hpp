@@ -0,0 +1,143 @@
+#ifndef MKVDB_BTREE_KEY_VALUE_BATCH_HPP_
+#define MKVDB_BTREE_KEY_VALUE_BATCH_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    /// Batch of key/value pairs stored by columns. The keys are stored one after the other in a
+    /// single buffer, and the offset of each key in the buffer is stored in an array of offsets.
+    /// The values are stored in the same way:
+    ///
+    ///   key_offsets: | 0 | end of key 0 | end of key 1 | ... | end of key n - 1 |
+    ///   keys:        | key 0 | key 1 | ... | key n - 1 |
+    ///
+    /// A batch is meant to be reused: clearing it keeps the memory of its buffers.
+    class KeyValueBatch
+    {
+    public:
+        /// Constructor of an empty batch.
+        inline KeyValueBatch();
+
+        /// Returns the number of pairs in the batch.
+        inline std::size_t size() const { return key_offsets_.size() - 1; }
+
+        /// Indicate if the batch is empty.
+        inline bool empty() const { return size() == 0; }
+
+        /// Returns the total size of the keys and the values of the batch.
+        inline common::FileOffset byte_size() const { return keys_.size() + values_.size(); }
+
+        /// Returns the key of a pair.
+        /// @pre pos must be less than the size of the batch.
+        inline common::ConstByteSpan key(std::size_t pos) const;
+
+        /// Returns the value of a pair.
+        /// @pre pos must be less than the size of the batch.
+        inline common::ConstByteSpan value(std::size_t pos) const;
+
+        /// Returns the offsets of the keys. The key i goes from key_offsets()[i] to
+        /// key_offsets()[i + 1] in keys().
+        inline const std::vector<common::FileOffset>& key_offsets() const { return key_offsets_; }
+
+        /// Returns the keys of the batch, one after the other.
+        inline const std::vector<std::byte>& keys() const { return keys_; }
+
+        /// Returns the offsets of the values. The value i goes from value_offsets()[i] to
+        /// value_offsets()[i + 1] in values().
+        inline const std::vector<common::FileOffset>& value_offsets() const
+        {
+            return value_offsets_;
+        }
+
+        /// Returns the values of the batch, one after the other.
+        inline const std::vector<std::byte>& values() const { return values_; }
+
+        /// Remove all the pairs of the batch.
+        inline void Clear();
+
+        /// Add a pair at the end of the batch.
+        inline void Append(common::ConstByteSpan key, common::ConstByteSpan value);
+
+        /// Add a pair at the end of the batch and returns the buffers where its key and its value
+        /// must be written.
+        inline std::pair<common::ByteSpan, common::ByteSpan> Emplace(common::FileOffset key_size,
+                                                                     common::FileOffset value_size);
+
+        /// Remove the last pair of the batch.
+        /// @pre The batch must not be empty.
+        inline void PopBack();
+
+    private:
+        std::vector<common::FileOffset> key_offsets_;
+        std::vector<std::byte> keys_;
+        std::vector<common::FileOffset> value_offsets_;
+        std::vector<std::byte> values_;
+    };
+
+    KeyValueBatch::KeyValueBatch()
+    : key_offsets_(1, 0),
+      value_offsets_(1, 0)
+    {
+    }
+
+    common::ConstByteSpan KeyValueBatch::key(std::size_t pos) const
+    {
+        assert(pos < size());
+        return common::ConstByteSpan(keys_).subspan(key_offsets_[pos],
+                                                    key_offsets_[pos + 1] - key_offsets_[pos]);
+    }
+
+    common::ConstByteSpan KeyValueBatch::value(std::size_t pos) const
+    {
+        assert(pos < size());
+        return common::ConstByteSpan(values_).subspan(
+          value_offsets_[pos], value_offsets_[pos + 1] - value_offsets_[pos]);
+    }
+
+    void KeyValueBatch::Clear()
+    {
+        key_offsets_.resize(1);
+        keys_.clear();
+        value_offsets_.resize(1);
+        values_.clear();
+    }
+
+    void KeyValueBatch::Append(common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        key_offsets_.push_back(keys_.size() + key.size());
+        keys_.insert(keys_.end(), key.begin(), key.end());
+        value_offsets_.push_back(values_.size() + value.size());
+        values_.insert(values_.end(), value.begin(), value.end());
+    }
+
+    std::pair<common::ByteSpan, common::ByteSpan>
+      KeyValueBatch::Emplace(common::FileOffset key_size, common::FileOffset value_size)
+    {
+        auto key_offset   = keys_.size();
+        auto value_offset = values_.size();
+        keys_.resize(key_offset + key_size);
+        values_.resize(value_offset + value_size);
+        key_offsets_.push_back(keys_.size());
+        value_offsets_.push_back(values_.size());
+
+        return { common::ByteSpan(keys_).subspan(key_offset),
+                 common::ByteSpan(values_).subspan(value_offset) };
+    }
+
+    void KeyValueBatch::PopBack()
+    {
+        assert(!empty());
+        key_offsets_.pop_back();
+        keys_.resize(key_offsets_.back());
+        value_offsets_.pop_back();
+        values_.resize(value_offsets_.back());
+    }
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_KEY_VALUE_BATCH_HPP_
\ No newline at end of file
@@ -5,30 +5,84 @@
 
 #include "mkvdb/pager/Page.hpp"
 
+#include "Cell.hpp"
 #include "NodeHeader.hpp"
+#include "SlotArray.hpp"
+
+#include <cstddef>
+#include <vector>
 
 namespace mkvdb::btree
 {
     /// Base class for all nodes (internal and leaf) in a b+tree.
+    ///
+    /// A node is stored in a page with the following layout:
+    ///
+    ///   | NodeHeader | SlotArray -> | unallocated space | <- Cells |
+    ///
+    /// The slot array contains the offsets of the cells sorted in the order of their keys. The
+    /// cells are allocated from the end of the page toward the slot array.
+    ///
+    /// The keys of a node often share a long prefix. This prefix is stored once, between the header
+    /// and the slot array, and the cells only contain the suffixes of the keys. The prefix of a
+    /// node is chosen from the separators bounding the node in its parent (its fence keys), so all
+    /// the keys that can ever be inserted in the node share it.
+    ///
+    /// The cells of a leaf node contain the keys and their values. The cells of an inner node
+    /// contain separator keys and, as their value, the index of a child page. The child of the
+    /// cell at position i contains the keys smaller than the key of the cell and greater or equal
+    /// to the key of the cell at position i - 1. The keys greater or equal to the last separator
+    /// are in the rightmost child, stored in the header.
+    ///
+    /// The leaves are also linked to their left and right siblings, so they can be scanned in the
+    /// order of the keys without going back to their parents.
+    ///
+    /// The header, the offsets of the slot array and the sizes of the cells are stored in the byte
+    /// order of the page (see pager::Page::byte_order). The child indexes of an inner node are
+    /// values of its cells, so like the keys and the other values they don't depend on it.
     class Node
     {
     public:
+        /// Result of a search in a node.
+        struct SearchResult
+        {
+            /// Position of the first key greater or equal to the key searched.
+            NodeHeader::NodeSize position;
+
+            /// Indicate if the key at position is equal to the key searched.
+            bool found;
+        };
+
         /// Constructor.
         ///
         /// Parameters:
         ///  page: Page containing the nodes data.
         inline Node(pager::Page& page)
         : page_(page),
-          header_(page_.content().subspan(0, NodeHeader::HEADER_SIZE))
+          header_(page_.content().subspan(0, NodeHeader::HEADER_SIZE), page_.byte_order())
         {
         }
 
+        /// Returns the maximum size of a cell that can be inserted in a node stored in a page
+        /// content of the given size. The size is limited so a node always holds at least four
+        /// cells, which guarantees that both halves of a split fit in their node.
+        /// @param content_size Size of the content of the page.
+        static inline common::ValueSize MaxCellSize(common::FileOffset content_size);
+
         /// Initialize a new node
-        void InitializeNewNode()
-        {
-            header_.size(0);
-            header_.byte_size(0);
-        }
+        /// @param type Type of the new node.
+        /// @param prefix Prefix shared by all the keys of the node.
+        void InitializeNewNode(NodeHeader::NodeType type   = NodeHeader::NodeType::Leaf,
+                               common::ConstByteSpan prefix = {});
+
+        /// Returns the page containing the node.
+        inline pager::Page& page() const { return page_; }
+
+        /// Returns the type of the node.
+        inline NodeHeader::NodeType type() const { return header_.type(); }
+
+        /// Indicate if the node is a leaf node.
+        inline bool is_leaf() const { return header_.type() == NodeHeader::NodeType::Leaf; }
 
         /// Returns the size of the node.
         /// @return The size of the node.
@@ -38,15 +92,194 @@ namespace mkvdb::btree
         /// @return The byte size of the node.
         NodeHeader::ByteSize byte_size() const { return header_.byte_size(); }
 
+        /// Returns the size of the unallocated space of the node.
+        NodeHeader::NodeSize unallocated_space() const { return header_.unallocated_space(); }
+
+        /// Returns the free space of the node. This is the unallocated space plus the space left
+        /// by the cells erased from the middle of the cells area.
+        inline common::FileOffset free_space() const;
+
+        /// Returns the prefix shared by all the keys of the node.
+        inline common::ConstByteSpan prefix() const
+        {
+            return page_.content().subspan(NodeHeader::HEADER_SIZE, header_.prefix_size());
+        }
+
+        /// Returns the suffix of the key of the cell at a given position. The key is the prefix of
+        /// the node followed by this suffix.
+        /// @pre pos must be less than the size of the node.
+        inline common::ConstByteSpan SuffixAt(NodeHeader::NodeSize pos) const;
+
+        /// Copy the key of the cell at a given position.
+        /// @param pos Position of the cell. Must be less than the size of the node.
+        /// @param key Receives the key.
+        inline void CopyKeyAt(NodeHeader::NodeSize pos, std::vector<std::byte>& key) const;
+
+        /// Returns the value of the cell at a given position.
+        /// @pre pos must be less than the size of the node.
+        inline common::ConstByteSpan ValueAt(NodeHeader::NodeSize pos) const;
+
+        /// Indicate if the value of the cell at a given position describes an overflow.
+        /// @pre pos must be less than the size of the node.
+        inline bool HasOverflowAt(NodeHeader::NodeSize pos) const
+        {
+            return CellAt(pos).has_overflow();
+        }
+
+        /// Search a key in the node. The search runs over the heads of the slot array and only
+        /// reads the cells whose head is equal to the head of the key.
+        /// @return The position of the first key greater or equal to the searched key and whether
+        /// this key is equal to the searched key.
+        SearchResult Find(common::ConstByteSpan key) const;
+
+        /// Indicate if a cell with a key and a value of the given sizes can be inserted in the
+        /// free space of the node. The key size is the size of the whole key, including the prefix
+        /// of the node. A cell that fits in the free space but not in the unallocated space is
+        /// inserted after the node is compacted (see Compact).
+        inline bool CanInsert(common::ValueSize key_size, common::ValueSize value_size) const;
+
+        /// @brief Inserts a key/value pair into the node at a given position.
+        /// @param pos Position of the new cell. Must be less or equal to the size of the node.
+        /// @param key The key to insert.
+        /// @param value The value to insert.
+        /// @param has_overflow Indicate if the value describes an overflow (see OverflowReference).
+        /// @pre The cell must fit in the node (see CanInsert), the key must start with the prefix
+        /// of the node and inserting at pos must keep the keys sorted.
+        void Insert(NodeHeader::NodeSize pos,
+                    common::ConstByteSpan key,
+                    common::ConstByteSpan value,
+                    bool has_overflow = false);
+
         /// @brief Inserts a key/value pair into the node.
         /// @param key The key to insert.
         /// @param value The value to insert.
+        /// @pre The cell must fit in the node (see CanInsert), the key must start with the prefix
+        /// of the node and must not be in the node.
         void Insert(common::ConstByteSpan key, common::ConstByteSpan value);
 
+        /// Overwrite the value of the cell at a given position.
+        /// @pre pos must be less than the size of the node and the new value must have the same
+        /// size as the current value.
+        void ReplaceValue(NodeHeader::NodeSize pos, common::ConstByteSpan value);
+
+        /// Erase the cell at a given position.
+        /// @pre pos must be less than the size of the node.
+        void Erase(NodeHeader::NodeSize pos);
+
+        /// Move the cells to the end of the node, so the holes left by the erased cells join the
+        /// unallocated space. The node is rebuilt in place from a copy of its content kept in a
+        /// scratch buffer of the thread, so a compaction doesn't allocate.
+        void Compact();
+
+        /// Returns the position of the child that may contain a key in an inner node.
+        /// @return A position between 0 and size(). The position size() designates the rightmost
+        /// child.
+        inline NodeHeader::NodeSize FindChildPosition(common::ConstByteSpan key) const;
+
+        /// Returns the index of the child page at a given position of an inner node.
+        /// @param pos Position of the child. The position size() designates the rightmost child.
+        inline pager::Page::PageIndex ChildAt(NodeHeader::NodeSize pos) const;
+
+        /// Set the index of the child page at a given position of an inner node.
+        /// @param pos Position of the child. The position size() designates the rightmost child.
+        void SetChildAt(NodeHeader::NodeSize pos, pager::Page::PageIndex index);
+
+        /// Returns the index of the rightmost child of an inner node.
+        inline pager::Page::PageIndex right_child() const { return header_.right_child(); }
+
+        /// Returns the index of the previous leaf, or 0 if the node is the first leaf.
+        inline pager::Page::PageIndex left_sibling() const { return header_.left_sibling(); }
+
+        /// Returns the index of the next leaf, or 0 if the node is the last leaf.
+        inline pager::Page::PageIndex right_sibling() const { return header_.right_sibling(); }
+
+        /// Set the index of the previous leaf of a leaf node.
+        void SetLeftSibling(pager::Page::PageIndex index);
+
+        /// Set the index of the next leaf of a leaf node.
+        void SetRightSibling(pager::Page::PageIndex index);
+
     private:
+        /// Returns the offset of the first cell of the cells area.
+        inline common::FileOffset cells_offset() const
+        {
+            return NodeHeader::HEADER_SIZE + header_.prefix_size()
+                   + header_.size() * SlotArray::SLOT_SIZE + header_.unallocated_space();
+        }
+
+        /// Returns the cell at a given position.
+        inline Cell CellAt(NodeHeader::NodeSize pos) const;
+
         pager::Page& page_;
         NodeHeader header_;
     };
+
+    common::ValueSize Node::MaxCellSize(common::FileOffset content_size)
+    {
+        return static_cast<common::ValueSize>((content_size - NodeHeader::HEADER_SIZE) / 4
+                                              - SlotArray::SLOT_SIZE);
+    }
+
+    common::FileOffset Node::free_space() const
+    {
+        return page_.content().size() - NodeHeader::HEADER_SIZE - header_.prefix_size()
+               - header_.size() * SlotArray::SLOT_SIZE - header_.byte_size();
+    }
+
+    Cell Node::CellAt(NodeHeader::NodeSize pos) const
+    {
+        auto content = page_.content();
+        auto header  = header_;
+        auto offset  = SlotArray(header, content).At(pos);
+        auto cell    = content.subspan(offset);
+        auto order   = header.byte_order();
+        return Cell(cell.subspan(0, Cell::ReadSize(cell, order)), order);
+    }
+
+    common::ConstByteSpan Node::SuffixAt(NodeHeader::NodeSize pos) const
+    {
+        return CellAt(pos).key();
+    }
+
+    void Node::CopyKeyAt(NodeHeader::NodeSize pos, std::vector<std::byte>& key) const
+    {
+        auto node_prefix = prefix();
+        auto suffix      = SuffixAt(pos);
+        key.assign(node_prefix.begin(), node_prefix.end());
+        key.insert(key.end(), suffix.begin(), suffix.end());
+    }
+
+    common::ConstByteSpan Node::ValueAt(NodeHeader::NodeSize pos) const
+    {
+        return CellAt(pos).value();
+    }
+
+    bool Node::CanInsert(common::ValueSize key_size, common::ValueSize value_size) const
+    {
+        assert(key_size >= header_.prefix_size());
+
+        return Cell::CalculateRequiredSize(key_size - header_.prefix_size(), value_size)
+                 + SlotArray::SLOT_SIZE
+               <= free_space();
+    }
+
+    NodeHeader::NodeSize Node::FindChildPosition(common::ConstByteSpan key) const
+    {
+        auto result = Find(key);
+        return result.found ? result.position + 1 : result.position;
+    }
+
+    pager::Page::PageIndex Node::ChildAt(NodeHeader::NodeSize pos) const
+    {
+        assert(!is_leaf());
+        assert(pos <= size());
+
+        if(pos == size())
+        {
+            return header_.right_child();
+        }
+        return common::Deserialize<pager::Page::PageIndex>(ValueAt(pos));
+    }
 } // namespace mkvdb::btree
 
 #endif // MKVDB_BTREE_NODE_HPP_
\ No newline at end of file
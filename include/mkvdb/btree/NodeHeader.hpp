@@ -1,26 +1,43 @@
 #ifndef MKVDB_BTREE_NODE_HEADER_HPP_
 #define MKVDB_BTREE_NODE_HEADER_HPP_
 
-#include "mkvdb/common/Serialization.hpp"
+#include "mkvdb/common/Field.hpp"
 
+#include "mkvdb/pager/Page.hpp"
+
+#include <bit>
 #include <cstdint>
 
 namespace mkvdb::btree
 {
-    /// Class representing the header part of a btree nodes.
+    /// Class representing the header part of a btree nodes. The fields are stored in the byte
+    /// order of the file (see pager::Header::Initialize).
     class NodeHeader
     {
     public:
         using NodeSize = std::uint16_t;
         using ByteSize = std::uint32_t;
 
+        /// Type of a node.
+        enum class NodeType : std::uint8_t
+        {
+            Leaf       = 1, ///< Leaf node, the cells contains the keys and their values.
+            Inner      = 2, ///< Inner node, the cells contains separator keys and child indexes.
+            FixedLeaf  = 3, ///< Leaf node of fixed-size keys and values (see FixedNode).
+            FixedInner = 4  ///< Inner node of fixed-size keys and child page indexes.
+        };
+
         /// Size of the buffer needed to store the NodeHeader.
-        static const common::FileOffset HEADER_SIZE = 8;
+        static const common::FileOffset HEADER_SIZE = 23;
 
         /// Constructor.
         /// @param buffer Buffer where the NodeHeader read and write it's data. The buffer must be
         /// of HEADER_SIZE size.
-        inline NodeHeader(common::ByteSpan buffer);
+        /// @param byte_order Byte order of the fields.
+        inline NodeHeader(common::ByteSpan buffer, std::endian byte_order = std::endian::big);
+
+        /// Returns the byte order of the fields of the node.
+        inline std::endian byte_order() const { return byte_order_; }
 
         /// Returns the number of items in the node.
         inline NodeSize size() const;
@@ -42,55 +59,140 @@ namespace mkvdb::btree
         /// Set the size of the unallocated space in the node.
         inline void unallocated_space(NodeSize new_unallocated_space);
 
+        /// Returns the type of the node.
+        inline NodeType type() const;
+
+        /// Set the type of the node.
+        inline void type(NodeType new_type);
+
+        /// Returns the index of the rightmost child of an inner node. The rightmost child contains
+        /// all the keys greater or equal to the last separator key of the node.
+        inline pager::Page::PageIndex right_child() const;
+
+        /// Set the index of the rightmost child of an inner node.
+        inline void right_child(pager::Page::PageIndex new_right_child);
+
+        /// Returns the size of the prefix shared by all the keys of the node. The prefix is stored
+        /// right after the header.
+        inline NodeSize prefix_size() const;
+
+        /// Set the size of the prefix shared by all the keys of the node.
+        inline void prefix_size(NodeSize new_prefix_size);
+
+        /// Returns the index of the previous leaf in the order of the keys, or 0 for the first
+        /// leaf. The page 0 holds the file header, so it is never a node.
+        inline pager::Page::PageIndex left_sibling() const;
+
+        /// Set the index of the previous leaf.
+        inline void left_sibling(pager::Page::PageIndex new_left_sibling);
+
+        /// Returns the index of the next leaf in the order of the keys, or 0 for the last leaf.
+        inline pager::Page::PageIndex right_sibling() const;
+
+        /// Set the index of the next leaf.
+        inline void right_sibling(pager::Page::PageIndex new_right_sibling);
+
     private:
-        static const common::FileOffset SIZE_SIZE              = 2;
-        static const common::FileOffset BYTE_SIZE_SIZE         = 4;
-        static const common::FileOffset UNALLOCATED_SPACE_SIZE = 2;
+        using SizeField             = common::Field<0, NodeSize>;
+        using ByteSizeField         = common::NextField<SizeField, ByteSize>;
+        using UnallocatedSpaceField = common::NextField<ByteSizeField, NodeSize>;
+        using TypeField             = common::NextField<UnallocatedSpaceField, NodeType>;
+        using RightChildField       = common::NextField<TypeField, pager::Page::PageIndex>;
+        using PrefixSizeField       = common::NextField<RightChildField, NodeSize>;
+        using LeftSiblingField      = common::NextField<PrefixSizeField, pager::Page::PageIndex>;
+        using RightSiblingField     = common::NextField<LeftSiblingField, pager::Page::PageIndex>;
 
-        static const common::FileOffset SIZE_OFFSET      = 0;
-        static const common::FileOffset BYTE_SIZE_OFFSET = SIZE_OFFSET + SIZE_SIZE;
-        static const common::FileOffset UNALLOCATED_SPACE_OFFSET =
-          BYTE_SIZE_OFFSET + BYTE_SIZE_SIZE;
+        static_assert(RightSiblingField::END == HEADER_SIZE);
 
         common::ByteSpan buffer_;
+        std::endian byte_order_;
     };
 
-    NodeHeader::NodeHeader(common::ByteSpan buffer)
+    NodeHeader::NodeHeader(common::ByteSpan buffer, std::endian byte_order)
+    : buffer_(buffer),
+      byte_order_(byte_order)
     {
         assert(buffer.size() == HEADER_SIZE);
-        buffer_ = buffer;
     }
 
     NodeHeader::NodeSize NodeHeader::size() const
     {
-        return common::Deserialize<NodeSize>(buffer_.subspan(SIZE_OFFSET, SIZE_SIZE));
+        return SizeField::Read(buffer_.data(), byte_order_);
     }
 
     void NodeHeader::size(NodeSize new_byte_size)
     {
-        common::Serialize(new_byte_size, buffer_.subspan(SIZE_OFFSET, SIZE_SIZE));
+        SizeField::Write(buffer_.data(), new_byte_size, byte_order_);
     }
 
     NodeHeader::ByteSize NodeHeader::byte_size() const
     {
-        return common::Deserialize<ByteSize>(buffer_.subspan(BYTE_SIZE_OFFSET, BYTE_SIZE_SIZE));
+        return ByteSizeField::Read(buffer_.data(), byte_order_);
     }
 
     void NodeHeader::byte_size(NodeHeader::ByteSize new_byte_size)
     {
-        common::Serialize(new_byte_size, buffer_.subspan(BYTE_SIZE_OFFSET, BYTE_SIZE_SIZE));
+        ByteSizeField::Write(buffer_.data(), new_byte_size, byte_order_);
     }
 
     NodeHeader::NodeSize NodeHeader::unallocated_space() const
     {
-        return common::Deserialize<NodeSize>(
-          buffer_.subspan(UNALLOCATED_SPACE_OFFSET, UNALLOCATED_SPACE_SIZE));
+        return UnallocatedSpaceField::Read(buffer_.data(), byte_order_);
     }
 
     void NodeHeader::unallocated_space(NodeHeader::NodeSize new_unallocated_space)
     {
-        common::Serialize(new_unallocated_space,
-                          buffer_.subspan(UNALLOCATED_SPACE_OFFSET, UNALLOCATED_SPACE_SIZE));
+        UnallocatedSpaceField::Write(buffer_.data(), new_unallocated_space, byte_order_);
+    }
+
+    NodeHeader::NodeType NodeHeader::type() const
+    {
+        return TypeField::Read(buffer_.data(), byte_order_);
+    }
+
+    void NodeHeader::type(NodeHeader::NodeType new_type)
+    {
+        TypeField::Write(buffer_.data(), new_type, byte_order_);
+    }
+
+    pager::Page::PageIndex NodeHeader::right_child() const
+    {
+        return RightChildField::Read(buffer_.data(), byte_order_);
+    }
+
+    void NodeHeader::right_child(pager::Page::PageIndex new_right_child)
+    {
+        RightChildField::Write(buffer_.data(), new_right_child, byte_order_);
+    }
+
+    NodeHeader::NodeSize NodeHeader::prefix_size() const
+    {
+        return PrefixSizeField::Read(buffer_.data(), byte_order_);
+    }
+
+    void NodeHeader::prefix_size(NodeHeader::NodeSize new_prefix_size)
+    {
+        PrefixSizeField::Write(buffer_.data(), new_prefix_size, byte_order_);
+    }
+
+    pager::Page::PageIndex NodeHeader::left_sibling() const
+    {
+        return LeftSiblingField::Read(buffer_.data(), byte_order_);
+    }
+
+    void NodeHeader::left_sibling(pager::Page::PageIndex new_left_sibling)
+    {
+        LeftSiblingField::Write(buffer_.data(), new_left_sibling, byte_order_);
+    }
+
+    pager::Page::PageIndex NodeHeader::right_sibling() const
+    {
+        return RightSiblingField::Read(buffer_.data(), byte_order_);
+    }
+
+    void NodeHeader::right_sibling(pager::Page::PageIndex new_right_sibling)
+    {
+        RightSiblingField::Write(buffer_.data(), new_right_sibling, byte_order_);
     }
 
 } // namespace mkvdb::btree
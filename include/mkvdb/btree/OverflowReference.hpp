@@ -0,0 +1,108 @@
+#ifndef MKVDB_BTREE_OVERFLOW_REFERENCE_HPP_
+#define MKVDB_BTREE_OVERFLOW_REFERENCE_HPP_
+
+#include "mkvdb/common/Serialization.hpp"
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+
+#include <cassert>
+
+namespace mkvdb::btree
+{
+    /// Reference to the part of a value stored out of its node, in an extent of consecutive
+    /// overflow pages. The value of a cell with an overflow is structured like this:
+    ///
+    ///    Offset Size Description
+    ///    ------ ---- -------------------------------------------------------------------
+    ///     0      4   Index of the first page of the extent.
+    ///     4      4   Size of the part of the value stored in the extent.
+    ///     8      ... Inline part of the value. The first bytes of the value are stored in the
+    ///                cell and the rest in the extent.
+    class OverflowReference
+    {
+    public:
+        /// Size of the reference, without the inline part of the value.
+        static const common::FileOffset REFERENCE_SIZE = 8;
+
+        /// Constructor.
+        /// @param cell_value Value of a cell with an overflow.
+        inline OverflowReference(common::ConstByteSpan cell_value);
+
+        /// Write a reference at the beginning of the value of a cell.
+        /// @param cell_value Value of the cell. The inline part is not written.
+        /// @param first_page Index of the first page of the extent.
+        /// @param overflow_size Size of the part of the value stored in the extent.
+        static inline void Write(common::ByteSpan cell_value,
+                                 pager::Page::PageIndex first_page,
+                                 common::ValueSize overflow_size);
+
+        /// Returns the number of pages needed to store an overflow.
+        static inline pager::Page::PageIndex CountPages(common::ValueSize overflow_size,
+                                                        pager::Page::PageSize page_size);
+
+        /// Returns the index of the first page of the extent.
+        inline pager::Page::PageIndex first_page() const;
+
+        /// Returns the size of the part of the value stored in the extent.
+        inline common::ValueSize overflow_size() const;
+
+        /// Returns the inline part of the value.
+        inline common::ConstByteSpan inline_part() const
+        {
+            return cell_value_.subspan(REFERENCE_SIZE);
+        }
+
+        /// Returns the size of the whole value.
+        inline common::FileOffset value_size() const
+        {
+            return inline_part().size() + overflow_size();
+        }
+
+    private:
+        static const common::FileOffset FIRST_PAGE_SIZE    = 4;
+        static const common::FileOffset OVERFLOW_SIZE_SIZE = 4;
+
+        static const common::FileOffset FIRST_PAGE_OFFSET    = 0;
+        static const common::FileOffset OVERFLOW_SIZE_OFFSET = FIRST_PAGE_OFFSET + FIRST_PAGE_SIZE;
+
+        common::ConstByteSpan cell_value_;
+    };
+
+    OverflowReference::OverflowReference(common::ConstByteSpan cell_value)
+    : cell_value_(cell_value)
+    {
+        assert(cell_value_.size() >= REFERENCE_SIZE);
+    }
+
+    void OverflowReference::Write(common::ByteSpan cell_value,
+                                  pager::Page::PageIndex first_page,
+                                  common::ValueSize overflow_size)
+    {
+        assert(cell_value.size() >= REFERENCE_SIZE);
+
+        common::Serialize(first_page, cell_value.subspan(FIRST_PAGE_OFFSET, FIRST_PAGE_SIZE));
+        common::Serialize(overflow_size,
+                          cell_value.subspan(OVERFLOW_SIZE_OFFSET, OVERFLOW_SIZE_SIZE));
+    }
+
+    pager::Page::PageIndex OverflowReference::CountPages(common::ValueSize overflow_size,
+                                                         pager::Page::PageSize page_size)
+    {
+        return static_cast<pager::Page::PageIndex>((overflow_size + page_size - 1) / page_size);
+    }
+
+    pager::Page::PageIndex OverflowReference::first_page() const
+    {
+        return common::Deserialize<pager::Page::PageIndex>(
+          cell_value_.subspan(FIRST_PAGE_OFFSET, FIRST_PAGE_SIZE));
+    }
+
+    common::ValueSize OverflowReference::overflow_size() const
+    {
+        return common::Deserialize<common::ValueSize>(
+          cell_value_.subspan(OVERFLOW_SIZE_OFFSET, OVERFLOW_SIZE_SIZE));
+    }
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_OVERFLOW_REFERENCE_HPP_
\ No newline at end of file
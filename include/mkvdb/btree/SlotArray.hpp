@@ -1,13 +1,34 @@
 #ifndef MKVDB_BTREE_SLOT_ARRAY_HPP_
 #define MKVDB_BTREE_SLOT_ARRAY_HPP_
 
+#include "mkvdb/common/Field.hpp"
+
+#include "HeadSearch.hpp"
 #include "NodeHeader.hpp"
 
 namespace mkvdb::btree
 {
+    /// Array of the offsets of the cells of a node, sorted in the order of their keys. The array is
+    /// stored right after the node header and the prefix of the node, and grows toward the end of
+    /// the node.
+    ///
+    /// Each slot also holds the head of the key of its cell (see MakeHead). The heads and the
+    /// offsets are stored in two parallel arrays:
+    ///
+    ///   | heads (HEAD_SIZE bytes per slot) | offsets (PAGE_OFFSET_SIZE bytes per slot) |
+    ///
+    /// so a search can scan the contiguous heads without reading the cells. The offsets are stored
+    /// in the byte order of the node header. The heads are always stored in big-endian order, so
+    /// their order as integers is the order of the keys.
     class SlotArray
     {
     public:
+        /// Size of a page offset in the slot array in bytes.
+        static const common::FileOffset PAGE_OFFSET_SIZE = 2;
+
+        /// Size of a slot (head and offset) in bytes.
+        static const common::FileOffset SLOT_SIZE = HEAD_SIZE + PAGE_OFFSET_SIZE;
+
         /// Constructor.
         /// @param header The header of the node.
         /// @param content_buffer The buffer containing the content of the node.
@@ -17,19 +38,43 @@ namespace mkvdb::btree
         /// @param pos Position where to insert the offset. The position must be less or equal than
         /// the size of the array.
         /// @param offset Offset to insert.
-        void Insert(std::uint16_t pos, std::uint16_t offset);
+        /// @param head Head of the key of the cell at offset.
+        void Insert(std::uint16_t pos, std::uint16_t offset, std::uint32_t head = 0);
 
         /// Get the offset at the given position.
         /// @param pos Position of the offset to get. Must be less than the size of the array.
         std::uint16_t At(std::uint16_t pos) const;
 
+        /// Overwrite the offset at the given position. The head is unchanged.
+        /// @param pos Position of the offset to set. Must be less than the size of the array.
+        /// @param offset New offset of the cell.
+        void Set(std::uint16_t pos, std::uint16_t offset);
+
+        /// Get the head at the given position.
+        /// @param pos Position of the head to get. Must be less than the size of the array.
+        std::uint32_t HeadAt(std::uint16_t pos) const;
+
         /// Erase the offset at the given position.
         /// @param pos Position of the offset to erase. Must be less than the size of the array.
         void Erase(std::uint16_t pos);
 
+        /// Returns the position of the first head greater or equal to a value.
+        /// @pre The heads must be sorted.
+        std::uint16_t LowerBound(std::uint32_t head) const;
+
+        /// Returns the position of the first head greater than a value.
+        /// @pre The heads must be sorted.
+        std::uint16_t UpperBound(std::uint32_t head) const;
+
     private:
-        /// Size of a page offset in the slot array in bytes.
-        static const common::FileOffset PAGE_OFFSET_SIZE = 2;
+        /// Number of heads under which a search stops halving the range and scans it.
+        static const std::uint16_t SCAN_THRESHOLD = 32;
+
+        /// Field of an offset, relative to the beginning of its slot in the offsets array.
+        using OffsetField = common::Field<0, std::uint16_t>;
+
+        /// Returns the offset of the offsets array in the buffer.
+        inline common::FileOffset offsets_offset() const { return header_.size() * HEAD_SIZE; }
 
         NodeHeader& header_;
         common::ByteSpan buffer_;
@@ -37,7 +82,7 @@ namespace mkvdb::btree
 
     SlotArray::SlotArray(NodeHeader& header, common::ByteSpan content_buffer)
     : header_(header),
-      buffer_(content_buffer.subspan(NodeHeader::HEADER_SIZE, header.size() * PAGE_OFFSET_SIZE))
+      buffer_(content_buffer.subspan(NodeHeader::HEADER_SIZE + header.prefix_size()))
     {
     }
 
@@ -0,0 +1,54 @@
+#ifndef MKVDB_BTREE_VALUE_READER_HPP_
+#define MKVDB_BTREE_VALUE_READER_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    /// Stream reading a value of a B-tree by chunks. The part of a large value stored in overflow
+    /// pages is copied straight from the pages to the buffers of the caller, so the value is never
+    /// held in memory as a whole.
+    ///
+    /// A reader is only valid while the value is not replaced or deleted from the tree.
+    class ValueReader
+    {
+    public:
+        /// Constructor.
+        /// @param pager Pager containing the overflow pages of the value.
+        /// @param cell_value Value of the cell of the value.
+        /// @param has_overflow Indicate if the cell value describes an overflow (see
+        /// OverflowReference).
+        ValueReader(pager::Pager& pager, common::ConstByteSpan cell_value, bool has_overflow);
+
+        /// Returns the size of the value.
+        inline common::FileOffset size() const { return inline_part_.size() + overflow_size_; }
+
+        /// Returns the position of the next read in the value.
+        inline common::FileOffset position() const { return position_; }
+
+        /// Move the position of the next read.
+        /// @throw common::MkvDBException if the position is past the end of the value.
+        void Seek(common::FileOffset position);
+
+        /// Read the value from the current position and move the position after the bytes read.
+        /// @param buffer Buffer receiving the bytes read.
+        /// @return The number of bytes read. It is smaller than the size of the buffer when the
+        /// end of the value is reached.
+        std::size_t Read(common::ByteSpan buffer);
+
+    private:
+        pager::Pager& pager_;
+        std::vector<std::byte> inline_part_;
+        pager::Page::PageIndex first_page_;
+        common::ValueSize overflow_size_;
+        common::FileOffset position_;
+    };
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_VALUE_READER_HPP_
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef MKVDB_BTREE_VALUE_WRITER_HPP_
+#define MKVDB_BTREE_VALUE_WRITER_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include "mkvdb/pager/Page.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    class BTree;
+
+    /// Stream writing a value of a B-tree by chunks. The size of the value is given when the
+    /// writer is opened, so the part of a large value stored in overflow pages gets its extent of
+    /// consecutive pages up front and the chunks are copied straight into the pages. The value is
+    /// only added to the tree by Commit.
+    class ValueWriter
+    {
+    public:
+        ValueWriter(const ValueWriter&)            = delete;
+        ValueWriter& operator=(const ValueWriter&) = delete;
+
+        /// Destructor. The overflow pages of a value that was not committed are freed.
+        ~ValueWriter();
+
+        /// Returns the size of the value.
+        inline common::FileOffset size() const { return size_; }
+
+        /// Returns the number of bytes already written.
+        inline common::FileOffset position() const { return position_; }
+
+        /// Write the next bytes of the value.
+        /// @throw common::MkvDBException if the bytes go past the size of the value.
+        void Write(common::ConstByteSpan data);
+
+        /// Insert the key and the value in the tree. If the key is already in the tree its value is
+        /// replaced.
+        /// @throw common::MkvDBException if the value is not completely written.
+        void Commit();
+
+    private:
+        friend class BTree;
+
+        /// Constructor.
+        /// @param tree Tree where the value is inserted.
+        /// @param key Key of the value.
+        /// @param size Size of the value.
+        /// @throw common::MkvDBException if the key or the value is too large.
+        ValueWriter(BTree& tree, common::ConstByteSpan key, common::FileOffset size);
+
+        /// Returns the offset of the inline part of the value in the value of the cell.
+        common::FileOffset inline_offset() const;
+
+        BTree& tree_;
+        std::vector<std::byte> key_;
+
+        /// Value of the cell: the whole value, or a reference to the overflow pages followed by
+        /// the inline part of the value.
+        std::vector<std::byte> cell_value_;
+
+        common::FileOffset size_;
+        common::FileOffset inline_size_;
+        common::FileOffset position_;
+        pager::Page::PageIndex first_page_;
+        pager::Page::PageIndex pages_count_;
+        bool is_committed_;
+    };
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_VALUE_WRITER_HPP_
\ No newline at end of file
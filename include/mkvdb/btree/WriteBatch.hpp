@@ -0,0 +1,119 @@
+#ifndef MKVDB_BTREE_WRITE_BATCH_HPP_
+#define MKVDB_BTREE_WRITE_BATCH_HPP_
+
+#include "mkvdb/common/Types.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace mkvdb::btree
+{
+    /// Batch of puts and deletes applied to a B-tree at once (see BTree::Write).
+    ///
+    /// The keys and the values of the operations are copied one after the other in a single arena
+    /// buffer, so adding an operation doesn't allocate once the buffers have grown. A batch is
+    /// meant to be reused: clearing it keeps the memory of its buffers.
+    class WriteBatch
+    {
+    public:
+        /// Type of an operation.
+        enum class OperationType : std::uint8_t
+        {
+            Put,
+            Delete
+        };
+
+        /// Returns the number of operations in the batch.
+        inline std::size_t size() const { return operations_.size(); }
+
+        /// Indicate if the batch is empty.
+        inline bool empty() const { return operations_.empty(); }
+
+        /// Returns the total size of the keys and the values of the batch.
+        inline common::FileOffset byte_size() const { return arena_.size(); }
+
+        /// Returns the type of an operation.
+        /// @pre pos must be less than the size of the batch.
+        inline OperationType type(std::size_t pos) const;
+
+        /// Returns the key of an operation.
+        /// @pre pos must be less than the size of the batch.
+        inline common::ConstByteSpan key(std::size_t pos) const;
+
+        /// Returns the value of a put. The value of a delete is empty.
+        /// @pre pos must be less than the size of the batch.
+        inline common::ConstByteSpan value(std::size_t pos) const;
+
+        /// Add the insertion or the replacement of a key/value pair.
+        inline void Put(common::ConstByteSpan key, common::ConstByteSpan value);
+
+        /// Add the deletion of a key.
+        inline void Delete(common::ConstByteSpan key);
+
+        /// Remove all the operations of the batch.
+        inline void Clear();
+
+    private:
+        /// Location of an operation in the arena. The value follows the key.
+        struct Operation
+        {
+            common::FileOffset offset;
+            common::FileOffset key_size;
+            common::FileOffset value_size;
+            OperationType type;
+        };
+
+        /// Add an operation at the end of the batch.
+        inline void Add(OperationType type, common::ConstByteSpan key, common::ConstByteSpan value);
+
+        std::vector<Operation> operations_;
+        std::vector<std::byte> arena_;
+    };
+
+    WriteBatch::OperationType WriteBatch::type(std::size_t pos) const
+    {
+        assert(pos < size());
+        return operations_[pos].type;
+    }
+
+    common::ConstByteSpan WriteBatch::key(std::size_t pos) const
+    {
+        assert(pos < size());
+        const auto& operation = operations_[pos];
+        return common::ConstByteSpan(arena_).subspan(operation.offset, operation.key_size);
+    }
+
+    common::ConstByteSpan WriteBatch::value(std::size_t pos) const
+    {
+        assert(pos < size());
+        const auto& operation = operations_[pos];
+        return common::ConstByteSpan(arena_).subspan(operation.offset + operation.key_size,
+                                                     operation.value_size);
+    }
+
+    void WriteBatch::Put(common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        Add(OperationType::Put, key, value);
+    }
+
+    void WriteBatch::Delete(common::ConstByteSpan key)
+    {
+        Add(OperationType::Delete, key, {});
+    }
+
+    void WriteBatch::Clear()
+    {
+        operations_.clear();
+        arena_.clear();
+    }
+
+    void WriteBatch::Add(OperationType type, common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        operations_.push_back({ arena_.size(), key.size(), value.size(), type });
+        arena_.insert(arena_.end(), key.begin(), key.end());
+        arena_.insert(arena_.end(), value.begin(), value.end());
+    }
+} // namespace mkvdb::btree
+
+#endif // MKVDB_BTREE_WRITE_BATCH_HPP_
\ No newline at end of file
@@ -0,0 +1,147 @@
+#ifndef MKVDB_COMMON_FIELD_HPP_
+#define MKVDB_COMMON_FIELD_HPP_
+
+#include "mkvdb/common/Serialization.hpp"
+#include "mkvdb/common/Types.hpp"
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace mkvdb::common
+{
+    /// Type that can be stored in a Field: an unsigned integer or an enumeration of an unsigned
+    /// integer.
+    template<typename T>
+    concept FieldType =
+      (std::is_unsigned_v<T> && !std::is_same_v<T, bool>)
+      || (std::is_enum_v<T> && std::is_unsigned_v<std::underlying_type_t<T>>);
+
+    /// Compile-time descriptor of an integer stored at a fixed offset of an on-page structure. The
+    /// offset and the size are constants, so reading or writing the field is a single unaligned
+    /// load or store (and a byte swap when the byte order is not the native order) without any
+    /// bounds computation. The integer is stored in big-endian order unless another byte order is
+    /// given.
+    ///
+    /// The fields of a structure are declared one after the other with NextField, and the size of
+    /// the structure is the end of its last field:
+    ///
+    ///     using SizeField  = common::Field<0, std::uint16_t>;
+    ///     using CountField = common::NextField<SizeField, std::uint32_t>;
+    ///     static_assert(CountField::END == HEADER_SIZE);
+    template<std::size_t Offset, FieldType T>
+    struct Field
+    {
+        using Type = T;
+
+        /// Offset of the field in the structure.
+        static constexpr std::size_t OFFSET = Offset;
+
+        /// Size of the field in bytes.
+        static constexpr std::size_t SIZE = sizeof(T);
+
+        /// Offset of the first byte after the field.
+        static constexpr std::size_t END = Offset + SIZE;
+
+        /// Read the field of a structure.
+        /// @param base Pointer to the first byte of the structure.
+        static inline T Read(const std::byte* base);
+
+        /// Read the field of a structure stored in a given byte order.
+        /// @param base Pointer to the first byte of the structure.
+        /// @param order Byte order of the integer, big-endian or little-endian.
+        static inline T Read(const std::byte* base, std::endian order);
+
+        /// Read the field of a structure.
+        /// @param buffer Buffer starting with the structure.
+        /// @pre The buffer must be at least END bytes long.
+        static inline T Read(ConstByteSpan buffer);
+
+        /// Write the field of a structure.
+        /// @param base Pointer to the first byte of the structure.
+        static inline void Write(std::byte* base, T value);
+
+        /// Write the field of a structure in a given byte order.
+        /// @param base Pointer to the first byte of the structure.
+        /// @param order Byte order of the integer, big-endian or little-endian.
+        static inline void Write(std::byte* base, T value, std::endian order);
+
+        /// Write the field of a structure.
+        /// @param buffer Buffer starting with the structure.
+        /// @pre The buffer must be at least END bytes long.
+        static inline void Write(ByteSpan buffer, T value);
+    };
+
+    /// Field stored right after another one.
+    template<typename Previous, FieldType T>
+    using NextField = Field<Previous::END, T>;
+
+    namespace detail
+    {
+        /// Integer type storing the value of a field.
+        template<typename T>
+        using FieldInteger = typename std::conditional_t<std::is_enum_v<T>,
+                                                         std::underlying_type<T>,
+                                                         std::type_identity<T>>::type;
+
+        /// Convert an integer between the native byte order and another byte order.
+        template<typename Integer>
+        inline Integer ToByteOrder(Integer value, std::endian order)
+        {
+            if constexpr(sizeof(Integer) == 1)
+            {
+                return value;
+            }
+            else
+            {
+                return order == std::endian::native ? value : ReverseBytes(value);
+            }
+        }
+    } // namespace detail
+
+    template<std::size_t Offset, FieldType T>
+    T Field<Offset, T>::Read(const std::byte* base)
+    {
+        return Read(base, std::endian::big);
+    }
+
+    template<std::size_t Offset, FieldType T>
+    T Field<Offset, T>::Read(const std::byte* base, std::endian order)
+    {
+        // memcpy of a constant size compiles to a single unaligned load.
+        detail::FieldInteger<T> value;
+        std::memcpy(&value, base + OFFSET, SIZE);
+        return static_cast<T>(detail::ToByteOrder(value, order));
+    }
+
+    template<std::size_t Offset, FieldType T>
+    T Field<Offset, T>::Read(ConstByteSpan buffer)
+    {
+        assert(buffer.size() >= END);
+        return Read(buffer.data());
+    }
+
+    template<std::size_t Offset, FieldType T>
+    void Field<Offset, T>::Write(std::byte* base, T value)
+    {
+        Write(base, value, std::endian::big);
+    }
+
+    template<std::size_t Offset, FieldType T>
+    void Field<Offset, T>::Write(std::byte* base, T value, std::endian order)
+    {
+        auto stored = detail::ToByteOrder(static_cast<detail::FieldInteger<T>>(value), order);
+        std::memcpy(base + OFFSET, &stored, SIZE);
+    }
+
+    template<std::size_t Offset, FieldType T>
+    void Field<Offset, T>::Write(ByteSpan buffer, T value)
+    {
+        assert(buffer.size() >= END);
+        Write(buffer.data(), value);
+    }
+} // namespace mkvdb::common
+
+#endif // MKVDB_COMMON_FIELD_HPP_
\ No newline at end of file
@@ -0,0 +1,198 @@
+#ifndef MKVDB_COMMON_KEY_ENCODER_HPP_
+#define MKVDB_COMMON_KEY_ENCODER_HPP_
+
+#include "mkvdb/common/Serialization.hpp"
+#include "mkvdb/common/Types.hpp"
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace mkvdb::common
+{
+    /// Type that a KeyEncoder encodes as a fixed-size number.
+    template<typename T>
+    concept KeyNumber = (std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, float>
+                        || std::same_as<T, double>;
+
+    /// Encoder of composite keys into bytes whose lexicographical order (the order of memcmp
+    /// and of the B-tree keys) is the logical order of the values encoded:
+    ///
+    ///   - Unsigned integers are stored in big-endian order.
+    ///   - Signed integers have their sign bit flipped, so negative values come first.
+    ///   - Floating-point numbers have their sign bit flipped when they are positive, and all their
+    ///     bits flipped when they are negative. -0.0 is encoded before 0.0. Every NaN, whatever its
+    ///     sign and payload, is encoded as the same positive quiet NaN, after the infinities.
+    ///   - Strings and byte strings have their 0x00 bytes escaped as 0x00 0xFF and end with 0x00
+    ///     0x01, so a string is ordered before the strings it is a prefix of.
+    ///
+    /// Every value has a known size or an end marker, so a tuple is encoded by encoding its values
+    /// one after the other, and tuples are ordered by their first value, then their second value,
+    /// etc. The encoded values carry no type information: they must be decoded with the same types
+    /// (see KeyDecoder).
+    class KeyEncoder
+    {
+    public:
+        /// Returns the encoded key.
+        inline ConstByteSpan key() const { return buffer_; }
+
+        /// Returns the size of the encoded key.
+        inline std::size_t size() const { return buffer_.size(); }
+
+        /// Remove the values encoded, keeping the memory of the buffer.
+        inline void Clear() { buffer_.clear(); }
+
+        /// Encode a number.
+        template<KeyNumber T>
+        inline KeyEncoder& Add(T value);
+
+        /// Encode a string.
+        KeyEncoder& Add(std::string_view value);
+
+        /// Encode a string of bytes.
+        KeyEncoder& AddBytes(ConstByteSpan value);
+
+        /// Encode the values of a tuple one after the other.
+        template<typename... Ts>
+        inline KeyEncoder& AddTuple(const std::tuple<Ts...>& values);
+
+    private:
+        std::vector<std::byte> buffer_;
+    };
+
+    /// Decoder of the keys encoded by a KeyEncoder. The values must be read in the order and with
+    /// the types they were encoded with.
+    class KeyDecoder
+    {
+    public:
+        /// Constructor.
+        /// @param key The encoded key. It must stay valid while it is decoded.
+        explicit KeyDecoder(ConstByteSpan key);
+
+        /// Indicate if all the values of the key were read.
+        inline bool at_end() const { return position_ == key_.size(); }
+
+        /// Decode a number or a string.
+        /// @throw MkvDBException if the key is too short or if a string is not properly escaped.
+        template<typename T>
+        inline T Read();
+
+        /// Decode a string of bytes.
+        /// @throw MkvDBException if the key is too short or if the bytes are not properly escaped.
+        std::vector<std::byte> ReadBytes();
+
+        /// Decode the values of a tuple.
+        /// @throw MkvDBException if the key is too short or if a string is not properly escaped.
+        template<typename... Ts>
+        inline std::tuple<Ts...> ReadTuple();
+
+    private:
+        /// Returns the next bytes of the key and moves after them.
+        /// @throw MkvDBException if the key is too short.
+        ConstByteSpan Take(std::size_t size);
+
+        ConstByteSpan key_;
+        std::size_t position_;
+    };
+
+    namespace detail
+    {
+        /// Unsigned integer of the same size as a number, holding its order-preserving encoding.
+        template<typename T>
+        using KeyBits = std::conditional_t<
+          sizeof(T) == 1,
+          std::uint8_t,
+          std::conditional_t<sizeof(T) == 2,
+                             std::uint16_t,
+                             std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+        /// Returns the bits of a number, transformed so their unsigned order is the order of the
+        /// numbers.
+        template<KeyNumber T>
+        inline KeyBits<T> ToOrderedBits(T value)
+        {
+            using Bits          = KeyBits<T>;
+            constexpr Bits SIGN = Bits(1) << (sizeof(T) * 8 - 1);
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                // A NaN with its sign bit set would be ordered before -inf.
+                constexpr Bits NAN_BITS =
+                  Bits(std::bit_cast<Bits>(std::numeric_limits<T>::quiet_NaN()) & ~SIGN);
+                auto bits = std::isnan(value) ? NAN_BITS : std::bit_cast<Bits>(value);
+                return (bits & SIGN) ? Bits(~bits) : Bits(bits | SIGN);
+            }
+            else if constexpr(std::is_signed_v<T>)
+            {
+                return Bits(static_cast<Bits>(value) ^ SIGN);
+            }
+            else
+            {
+                return static_cast<Bits>(value);
+            }
+        }
+
+        /// Reverse of ToOrderedBits.
+        template<KeyNumber T>
+        inline T FromOrderedBits(KeyBits<T> bits)
+        {
+            using Bits          = KeyBits<T>;
+            constexpr Bits SIGN = Bits(1) << (sizeof(T) * 8 - 1);
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                return std::bit_cast<T>((bits & SIGN) ? Bits(bits & ~SIGN) : Bits(~bits));
+            }
+            else
+            {
+                return static_cast<T>(std::is_signed_v<T> ? Bits(bits ^ SIGN) : bits);
+            }
+        }
+    } // namespace detail
+
+    template<KeyNumber T>
+    KeyEncoder& KeyEncoder::Add(T value)
+    {
+        auto size = buffer_.size();
+        buffer_.resize(size + sizeof(T));
+        Serialize(detail::ToOrderedBits(value), ByteSpan(buffer_).subspan(size));
+        return *this;
+    }
+
+    template<typename... Ts>
+    KeyEncoder& KeyEncoder::AddTuple(const std::tuple<Ts...>& values)
+    {
+        std::apply([this](const auto&... value) { (Add(value), ...); }, values);
+        return *this;
+    }
+
+    template<typename T>
+    T KeyDecoder::Read()
+    {
+        if constexpr(std::is_same_v<T, std::string>)
+        {
+            auto bytes = ReadBytes();
+            return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+        else
+        {
+            static_assert(KeyNumber<T>);
+            return detail::FromOrderedBits<T>(Deserialize<detail::KeyBits<T>>(Take(sizeof(T))));
+        }
+    }
+
+    template<typename... Ts>
+    std::tuple<Ts...> KeyDecoder::ReadTuple()
+    {
+        // The values must be read from left to right, which a braced initializer guarantees.
+        return std::tuple<Ts...> { Read<Ts>()... };
+    }
+} // namespace mkvdb::common
+
+#endif // MKVDB_COMMON_KEY_ENCODER_HPP_
\ No newline at end of file
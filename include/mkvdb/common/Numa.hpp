@@ -0,0 +1,33 @@
+#ifndef MKVDB_COMMON_NUMA_HPP_
+#define MKVDB_COMMON_NUMA_HPP_
+
+#include <cstddef>
+
+namespace mkvdb::common
+{
+    /// Value used to indicate that memory can be allocated on any NUMA node.
+    constexpr std::size_t ANY_NUMA_NODE = static_cast<std::size_t>(-1);
+
+    /// Returns the number of NUMA nodes of the system. Returns one if the library was built
+    /// without NUMA support or if the system does not support NUMA.
+    std::size_t NumaNodesCount();
+
+    /// Returns the NUMA node of the CPU the calling thread is running on. The value is always less
+    /// than NumaNodesCount().
+    std::size_t CurrentNumaNode();
+
+    /// Allocate memory on a specific NUMA node. If NUMA is not supported, or if the node is
+    /// ANY_NUMA_NODE, the memory is allocated normally. The memory is zeroed by the calling
+    /// thread.
+    /// @param size Size of the memory block.
+    /// @param node Node where the memory must be allocated.
+    std::byte* AllocateOnNumaNode(std::size_t size, std::size_t node);
+
+    /// Release memory allocated by AllocateOnNumaNode.
+    /// @param memory Memory to release.
+    /// @param size Size of the memory block. Must be the size passed to AllocateOnNumaNode.
+    /// @param node Node passed to AllocateOnNumaNode.
+    void FreeNumaMemory(std::byte* memory, std::size_t size, std::size_t node);
+} // namespace mkvdb::common
+
+#endif // MKVDB_COMMON_NUMA_HPP_
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef MKVDB_COMMON_THREAD_POOL_HPP_
+#define MKVDB_COMMON_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mkvdb::common
+{
+    /// Fixed set of threads executing tasks in the order they are submitted.
+    class ThreadPool
+    {
+    public:
+        /// Constructor.
+        /// @param threads_count Number of threads in the pool. Must be greater than zero.
+        ThreadPool(std::size_t threads_count);
+
+        /// Destructor. The tasks already submitted are completed before the threads are joined.
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// Submit a task to be executed by one of the threads of the pool.
+        /// @return A future that becomes ready when the task is completed. If the task throws,
+        /// the exception is stored in the future.
+        std::future<void> Submit(std::function<void()> task);
+
+    private:
+        void Work();
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque<std::packaged_task<void()>> tasks_;
+        bool is_stopping_;
+        std::vector<std::thread> threads_;
+    };
+} // namespace mkvdb::common
+
+#endif // MKVDB_COMMON_THREAD_POOL_HPP_
\ No newline at end of file
@@ -7,15 +7,29 @@
 
 namespace mkvdb::fs
 {
+    /// Mode in which an existing file is opened.
+    enum class OpenMode
+    {
+        /// The file can be read and written.
+        ReadWrite,
+
+        /// The file can only be read. The file can be on a read-only medium.
+        ReadOnly
+    };
+
     /// Interface of objects that can read/write into a file.
     class IFile
     {
     public:
+        /// Destructor.
+        virtual ~IFile() = default;
+
         /// Creates a new file.
         virtual void Create() = 0;
 
         /// Opens an existing file.
-        virtual void Open() = 0;
+        /// @param mode Indicates if the file can be written.
+        virtual void Open(OpenMode mode = OpenMode::ReadWrite) = 0;
 
         /// Close the file.
         virtual void Close() = 0;
@@ -30,15 +44,24 @@ namespace mkvdb::fs
         /// Read a block of data from the file. The size of the block of data read is
         /// determined by the size of the buffer. The amount of data requested must be
         /// available, otherwise an exception is thrown. It is an error to try to read past
-        /// the end of the file.
+        /// the end of the file. Several threads can read from the file at the same time, as long
+        /// as no other operation is in progress.
         virtual void Read(common::ByteSpan buffer, common::FileOffset offset) = 0;
 
+        /// Indicates that a block of data will be read soon. Implementations can start loading it
+        /// asynchronously. This is only a hint, it has no visible effect on the content of the
+        /// file and it can be ignored.
+        virtual void WillNeed(common::FileOffset offset, common::FileOffset size) = 0;
+
         /// Flush all changes to the disk so it will not be lost in case of a crash or
         /// power failure.
         virtual void Sync() = 0;
 
         /// Get the file size.
         virtual common::FileOffset size() const = 0;
+
+        /// Indicates if the file was opened in read-only mode.
+        virtual bool is_read_only() const = 0;
     };
 
 } // namespace mkvdb::fs
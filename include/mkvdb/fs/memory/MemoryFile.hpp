@@ -23,7 +23,8 @@ namespace mkvdb::fs::memory
         void Create();
 
         /// Opens on existing file.
-        void Open();
+        /// @param mode Indicates if the file can be written.
+        void Open(OpenMode mode = OpenMode::ReadWrite);
 
         /// Close the file.
         void Close();
@@ -41,6 +42,11 @@ namespace mkvdb::fs::memory
         /// the end of the file.
         void Read(common::ByteSpan buffer, common::FileOffset offset);
 
+        /// Indicates that a block of data will be read soon. Implementations can start loading it
+        /// asynchronously. This is only a hint, it has no visible effect on the content of the
+        /// file and it can be ignored.
+        void WillNeed(common::FileOffset offset, common::FileOffset size);
+
         /// Flush all changes to the disk so it will not be lost in case of a crash or
         /// power failure.
         void Sync();
@@ -48,11 +54,15 @@ namespace mkvdb::fs::memory
         /// Get the file size.
         common::FileOffset size() const;
 
+        /// Indicates if the file was opened in read-only mode.
+        inline bool is_read_only() const { return is_read_only_; }
+
         /// Returns a bytespan on the content of the file.
         inline common::ConstByteSpan data() const { return data_; }
 
     private:
         bool is_opened_;
+        bool is_read_only_;
         std::vector<std::byte> data_;
     };
 } // namespace mkvdb::fs::memory
@@ -22,7 +22,9 @@ namespace mkvdb::fs::posix
         void Create();
 
         /// Opens an existing file.
-        void Open();
+        /// @param mode Indicates if the file can be written. In read-only mode the file is opened
+        /// with O_RDONLY, so it can be on a read-only medium.
+        void Open(OpenMode mode = OpenMode::ReadWrite);
 
         /// Close the file.
         void Close();
@@ -39,6 +41,12 @@ namespace mkvdb::fs::posix
         /// the end of the file.
         void Read(common::ByteSpan buffer, common::FileOffset offset);
 
+        /// Indicates that a block of data will be read soon. Implementations can start loading it
+        /// asynchronously. This is only a hint, it has no visible effect on the content of the
+        /// file and it can be ignored. A failure of the advice is ignored too.
+        /// @throw common::MkvDBException if the file is not opened.
+        void WillNeed(common::FileOffset offset, common::FileOffset size);
+
         /// Flush all changes to the disk so it will not be lost in case of a crash or
         /// power failure.
         void Sync();
@@ -46,11 +54,15 @@ namespace mkvdb::fs::posix
         /// Get the file size.
         common::FileOffset size() const;
 
+        /// Indicates if the file was opened in read-only mode.
+        inline bool is_read_only() const { return is_read_only_; }
+
     private:
         const int INVALID_FD = -1;
 
         std::string filename_;
         int fd_;
+        bool is_read_only_;
     };
 } // namespace mkvdb::fs::posix
 
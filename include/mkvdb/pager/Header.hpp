@@ -1,6 +1,7 @@
 #ifndef MKVDB_PAGER_HEADER_HPP_
 #define MKVDB_PAGER_HEADER_HPP_
 
+#include "mkvdb/common/Field.hpp"
 #include "mkvdb/common/Serialization.hpp"
 #include "mkvdb/common/Types.hpp"
 
@@ -8,6 +9,8 @@
 
 #include "mkvdb/pager/Page.hpp"
 
+#include <bit>
+
 namespace mkvdb::pager
 {
     /// Represents the database header.
@@ -24,6 +27,13 @@ namespace mkvdb::pager
     ///                page size of the data base can be calculated by shifting 0x1 left
     ///                by this value.
     ///     17     4   Size of the database file in pages.
+    ///     21     4   Index of the first page of the free list, or 0 if the free list is empty.
+    ///                The free list is made of extents of consecutive free pages. The first page
+    ///                of each extent stores the index of the first page of the next extent in its
+    ///                first four bytes and the number of pages of the extent in the next four.
+    ///     25     1   Byte order of the node headers, of the offsets of the slot arrays and of
+    ///                the sizes of the cells: 0 for big-endian, 1 for little-endian. The rest
+    ///                of the file, including this header and the free list, is big-endian.
     class Header
     {
     public:
@@ -32,9 +42,17 @@ namespace mkvdb::pager
         /// Read the page size from a file.
         static common::FileOffset ReadPageSize(fs::IFile& file);
 
+        /// Read the byte order of the nodes from a file.
+        /// @throw common::MkvDBException if the byte order stored in the file is unknown.
+        static std::endian ReadByteOrder(fs::IFile& file);
+
         /// Initialize the header of a new database
         /// @param page_size The size of the pages. Must be a power of two between 512 and 65536.
-        static void Initialize(fs::IFile& file, Page::PageSize page_size);
+        /// @param byte_order Byte order of the nodes. Choosing the native order of the machines
+        /// reading the file saves the byte swaps of the accesses to the nodes.
+        static void Initialize(fs::IFile& file,
+                               Page::PageSize page_size,
+                               std::endian byte_order = std::endian::big);
 
         /// Constructor.
         /// @param page Reference to the first page of the database.
@@ -49,35 +67,49 @@ namespace mkvdb::pager
         /// Set the number of pages
         inline void pages_count(Page::PageIndex count);
 
+        /// Returns the index of the first page of the free list, or 0 if the free list is empty.
+        inline Page::PageIndex first_free_page() const;
+
+        /// Set the index of the first page of the free list.
+        inline void first_free_page(Page::PageIndex index);
+
     private:
         static const std::string MAGIC_STRING;
 
-        static const common::FileOffset MAGIC_STRING_SIZE = 16;
-        static const common::FileOffset PAGE_SIZE_SIZE    = 1;
-        static const common::FileOffset PAGES_COUNT_SIZE  = 4;
-
         static const common::FileOffset MAGIC_STRING_OFFSET = 0;
-        static const common::FileOffset PAGE_SIZE_OFFSET = MAGIC_STRING_OFFSET + MAGIC_STRING_SIZE;
-        static const common::FileOffset PAGES_COUNT_OFFSET = PAGE_SIZE_OFFSET + PAGE_SIZE_SIZE;
+        static const common::FileOffset MAGIC_STRING_SIZE   = 16;
+
+        using PageSizeField      = common::Field<MAGIC_STRING_OFFSET + MAGIC_STRING_SIZE,
+                                                 std::uint8_t>;
+        using PagesCountField    = common::NextField<PageSizeField, Page::PageIndex>;
+        using FirstFreePageField = common::NextField<PagesCountField, Page::PageIndex>;
+        using ByteOrderField     = common::NextField<FirstFreePageField, std::uint8_t>;
 
-        inline common::ByteSpan pages_count_span() const;
+        static const std::uint8_t BIG_ENDIAN_VALUE    = 0;
+        static const std::uint8_t LITTLE_ENDIAN_VALUE = 1;
 
         std::shared_ptr<Page> page_;
     };
 
-    common::ByteSpan Header::pages_count_span() const
+    Page::PageIndex Header::pages_count() const
+    {
+        return PagesCountField::Read(page_->data());
+    }
+
+    void Header::pages_count(Page::PageIndex count)
     {
-        return page_->data().subspan(PAGES_COUNT_OFFSET, PAGES_COUNT_SIZE);
+        PagesCountField::Write(page_->data(), count);
+        page_->MarkAsModified();
     }
 
-    Page::PageIndex Header::pages_count() const
+    Page::PageIndex Header::first_free_page() const
     {
-        return common::Deserialize<Page::PageIndex>(pages_count_span());
+        return FirstFreePageField::Read(page_->data());
     }
 
-    void Header::pages_count(Page::PageIndex count)
+    void Header::first_free_page(Page::PageIndex index)
     {
-        common::Serialize(count, pages_count_span());
+        FirstFreePageField::Write(page_->data(), index);
         page_->MarkAsModified();
     }
 
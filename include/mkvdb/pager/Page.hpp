@@ -1,8 +1,12 @@
 #ifndef MKVDB_PAGER_PAGE_HPP_
 #define MKVDB_PAGER_PAGE_HPP_
 
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Numa.hpp"
 #include "mkvdb/common/Types.hpp"
 
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -18,7 +22,11 @@ namespace mkvdb::pager
         /// Constructor.
         /// @param index Index of the page in it's parent file.
         /// @param page_size Size of the page in bytes.
-        Page(PageIndex index, PageSize size);
+        /// @param numa_node NUMA node where the buffer of the page is allocated.
+        Page(PageIndex index, PageSize size, std::size_t numa_node = common::ANY_NUMA_NODE);
+
+        /// Returns the NUMA node where the buffer of the page is allocated.
+        inline std::size_t numa_node() const { return data_.get_deleter().numa_node; }
 
         /// Returns the index of the page in it's parent file.
         inline PageIndex index() const { return index_; };
@@ -39,16 +47,61 @@ namespace mkvdb::pager
         inline bool is_modified() const { return is_modified_; }
 
         /// Mark the page as modified.
-        inline void MarkAsModified() { is_modified_ = true; }
+        /// @throw common::MkvDBException if the page is read-only.
+        inline void MarkAsModified()
+        {
+            if(is_read_only_)
+            {
+                throw common::MkvDBException("Cannot modify the page, the page is read-only.");
+            }
+            is_modified_ = true;
+        }
 
         /// Mark the page as unmodified.
         inline void MarkAsUnmodified() { is_modified_ = false; }
 
+        /// Indicate if the page is read-only.
+        inline bool is_read_only() const { return is_read_only_; }
+
+        /// Mark the page as read-only. A read-only page can't be marked as modified, so it is never
+        /// written back to the file.
+        inline void MarkAsReadOnly() { is_read_only_ = true; }
+
+        /// Returns the byte order of the node stored in the page. It is the byte order chosen when
+        /// the file was created (see Header::Initialize).
+        inline std::endian byte_order() const { return byte_order_; }
+
+        /// Set the byte order of the node stored in the page.
+        inline void SetByteOrder(std::endian byte_order) { byte_order_ = byte_order; }
+
+        /// Reuse the page buffer to hold another page of the same file. The content of the page is
+        /// unspecified after this call and the page is marked as unmodified.
+        /// @param index Index of the page that will be stored in this buffer.
+        inline void Recycle(PageIndex index)
+        {
+            index_       = index;
+            is_modified_ = false;
+        }
+
     private:
+        /// Release a buffer allocated on a NUMA node.
+        struct BufferDeleter
+        {
+            PageSize size;
+            std::size_t numa_node;
+
+            inline void operator()(std::byte* buffer) const
+            {
+                common::FreeNumaMemory(buffer, size, numa_node);
+            }
+        };
+
         PageIndex index_;
         PageSize size_;
         bool is_modified_;
-        std::unique_ptr<std::byte[]> data_;
+        bool is_read_only_;
+        std::endian byte_order_;
+        std::unique_ptr<std::byte[], BufferDeleter> data_;
     };
 } // namespace mkvdb::pager
 
@@ -0,0 +1,61 @@
+#ifndef MKVDB_PAGER_PAGE_RING_HPP_
+#define MKVDB_PAGER_PAGE_RING_HPP_
+
+#include "mkvdb/pager/Page.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mkvdb::pager
+{
+    /// Small private set of frames used to load pages that are accessed sequentially (large scans,
+    /// backups, exports). The frames are reused in a round robin fashion, so a scan only ever uses
+    /// a bounded amount of memory and does not push the working set out of the pages cache.
+    class PageRing
+    {
+    public:
+        /// Constructor.
+        /// @param capacity Number of frames in the ring. Must be greater than zero.
+        /// @param page_size Size of the pages stored in the ring.
+        PageRing(std::size_t capacity, Page::PageSize page_size);
+
+        /// Returns the number of frames in the ring.
+        inline std::size_t capacity() const { return frames_.size(); }
+
+        /// Look for a page in the ring.
+        /// @return The page if it is currently stored in the ring, nullptr otherwise.
+        std::shared_ptr<Page> Find(Page::PageIndex index) const;
+
+        /// Remove a page from the ring.
+        /// @return The page removed from the ring or nullptr if the page was not in the ring.
+        std::shared_ptr<Page> Remove(Page::PageIndex index);
+
+        /// Returns a frame where the page at the given index can be loaded. The content of the
+        /// frame is unspecified.
+        ///
+        /// The frame at the current position of the ring is recycled if nobody else holds a
+        /// reference to it and it's not modified. Otherwise it can't be reused safely, so it is
+        /// handed back to the caller through `evicted` and a new frame is allocated in its place.
+        /// @param index Index of the page that will be loaded in the frame.
+        /// @param evicted Receives the previous page of the frame if it could not be recycled.
+        std::shared_ptr<Page> Acquire(Page::PageIndex index, std::shared_ptr<Page>& evicted);
+
+        /// Store a page that was loaded elsewhere in the frame at the current position of the
+        /// ring. The previous page of the frame is dropped under the same conditions as in
+        /// Acquire, otherwise it is handed back to the caller through `evicted`.
+        /// @param page Page to store in the ring.
+        /// @param evicted Receives the previous page of the frame if it could not be dropped.
+        void Insert(std::shared_ptr<Page> page, std::shared_ptr<Page>& evicted);
+
+        /// Returns the frames of the ring. Empty frames are nullptr.
+        inline const std::vector<std::shared_ptr<Page>>& frames() const { return frames_; }
+
+    private:
+        Page::PageSize page_size_;
+        std::size_t next_frame_;
+        std::vector<std::shared_ptr<Page>> frames_;
+    };
+} // namespace mkvdb::pager
+
+#endif // MKVDB_PAGER_PAGE_RING_HPP_
\ No newline at end of file
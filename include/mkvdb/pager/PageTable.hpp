@@ -0,0 +1,108 @@
+#ifndef MKVDB_PAGER_PAGE_TABLE_HPP_
+#define MKVDB_PAGER_PAGE_TABLE_HPP_
+
+#include "mkvdb/pager/Page.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace mkvdb::pager
+{
+    /// Policy used to place the pages cache on the NUMA nodes of the system.
+    enum class NumaPolicy
+    {
+        /// The pages are allocated without regard to NUMA nodes and kept in a single table.
+        Disabled,
+
+        /// The pages are allocated on the node of the thread that loads them and kept in the table
+        /// partition of that node.
+        LocalNode,
+
+        /// The pages are spread on the nodes by hashing their index. The node of a page is
+        /// known without searching every partition.
+        HashToNode
+    };
+
+    /// Statistics of the accesses to the pages cache made by the threads of a NUMA node.
+    struct CacheStatistics
+    {
+        /// Number of accesses served by a page allocated on the node of the thread.
+        std::size_t hits = 0;
+
+        /// Number of accesses served by a page allocated on another node.
+        std::size_t remote_hits = 0;
+
+        /// Number of accesses that required reading the page from the file.
+        std::size_t misses = 0;
+    };
+
+    /// Table of the pages cached by the pager. When NUMA is enabled, the table is divided in one
+    /// partition per NUMA node and the pages are allocated on the node of their partition.
+    class PageTable
+    {
+    public:
+        /// Constructor.
+        /// @param numa_policy Policy used to place the pages on the NUMA nodes.
+        PageTable(NumaPolicy numa_policy);
+
+        /// Returns the NUMA node where a new page with the given index must be allocated.
+        std::size_t NumaNodeFor(Page::PageIndex index) const;
+
+        /// Look for a page in the table.
+        /// @return The page if it is in the table, nullptr otherwise.
+        std::shared_ptr<Page> Find(Page::PageIndex index) const;
+
+        /// Indicates if a page is in the table.
+        inline bool Contains(Page::PageIndex index) const { return Find(index) != nullptr; }
+
+        /// Add a page in the partition of its NUMA node.
+        /// @param page Page to add. It must not already be in the table.
+        void Insert(std::shared_ptr<Page> page);
+
+        /// Returns the number of pages in the table.
+        std::size_t size() const;
+
+        /// Call a function for every page in the table.
+        template<typename Function>
+        void ForEach(Function function) const;
+
+        /// Register an access served by a page of the table.
+        void RecordHit(const Page& page);
+
+        /// Register an access that required reading a page from the file.
+        void RecordMiss();
+
+        /// Returns the statistics of the accesses, by NUMA node. When NUMA is disabled, all the
+        /// accesses are registered in a single entry.
+        inline const std::vector<CacheStatistics>& statistics() const { return statistics_; }
+
+    private:
+        using Partition = std::unordered_map<Page::PageIndex, std::shared_ptr<Page>>;
+
+        /// Returns the partition of the NUMA node of the calling thread.
+        std::size_t LocalPartition() const;
+
+        /// Returns the partition where a page is stored.
+        std::size_t PartitionOf(const Page& page) const;
+
+        NumaPolicy numa_policy_;
+        std::vector<Partition> partitions_;
+        std::vector<CacheStatistics> statistics_;
+    };
+
+    template<typename Function>
+    void PageTable::ForEach(Function function) const
+    {
+        for(const auto& partition : partitions_)
+        {
+            for(const auto& pair : partition)
+            {
+                function(pair.second);
+            }
+        }
+    }
+} // namespace mkvdb::pager
+
+#endif // MKVDB_PAGER_PAGE_TABLE_HPP_
\ No newline at end of file
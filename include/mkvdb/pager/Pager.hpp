@@ -1,41 +1,235 @@
 #ifndef MKVDB_PAGER_PAGER_HPP_
 #define MKVDB_PAGER_PAGER_HPP_
 
+#include "mkvdb/common/Field.hpp"
+#include "mkvdb/common/ThreadPool.hpp"
+
 #include "mkvdb/fs/IFile.hpp"
 
 #include "mkvdb/pager/Header.hpp"
 #include "mkvdb/pager/Page.hpp"
+#include "mkvdb/pager/PageRing.hpp"
+#include "mkvdb/pager/PageTable.hpp"
+#include "mkvdb/pager/Readahead.hpp"
 
+#include <bit>
+#include <cstddef>
+#include <future>
 #include <memory>
 #include <optional>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace mkvdb::pager
 {
+    /// Hint given to the pager about the way a page is going to be accessed.
+    enum class AccessHint
+    {
+        /// The page is part of the working set. It is kept in the pages cache.
+        Normal,
+
+        /// The page is read as part of a large scan and will probably not be needed again soon.
+        /// If the page is not already cached, it is loaded in a small ring of frames that are
+        /// recycled instead of being added to the pages cache.
+        Sequential
+    };
+
     /// Class responsible for separating the database into pages that can be read and
     /// written as single blocks.
+    ///
+    /// If the file is opened in read-only mode, the pager is read-only too. The pages it returns
+    /// can't be marked as modified and the operations that modify the database throw an exception.
+    /// Every thread can open its own read-only pager on the same file, since they don't share any
+    /// state.
     class Pager
     {
     public:
         /// Constructor
-        Pager(fs::IFile& file);
+        /// @param file File containing the database.
+        /// @param numa_policy Policy used to place the pages cache on the NUMA nodes.
+        /// @throw common::MkvDBException if the byte order stored in the file is unknown.
+        Pager(fs::IFile& file, NumaPolicy numa_policy = NumaPolicy::Disabled);
+
+        /// Indicates if the pager is read-only.
+        inline bool is_read_only() const { return is_read_only_; }
+
+        /// Returns the size of the pages.
+        inline Page::PageSize page_size() const { return page_size_; }
+
+        /// Returns the byte order of the nodes (see Header::Initialize).
+        inline std::endian byte_order() const { return byte_order_; }
 
         /// Get a pointer to a specific page.
-        std::shared_ptr<Page> GetPage(Page::PageIndex index);
+        /// @param index Index of the page.
+        /// @param hint Indicates how the page is going to be accessed.
+        std::shared_ptr<Page> GetPage(Page::PageIndex index, AccessHint hint = AccessHint::Normal);
 
         /// Returns a new page. The new page is either added at the end of the files or comme from a
         /// previously used page that is now on the free list. The content of the page is
         /// unspecified.
+        /// @throw common::MkvDBException if the pager is read-only.
         std::shared_ptr<Page> GetNewPage();
 
+        /// Returns a run of new pages with consecutive indexes, so they can be read back in a
+        /// single request. The pages are taken from the first extent of the free list that is
+        /// large enough, among the first ones, or added at the end of the file. The content of the
+        /// pages is unspecified.
+        /// @param count Number of pages.
+        /// @throw common::MkvDBException if the pager is read-only.
+        std::vector<std::shared_ptr<Page>> GetNewPages(Page::PageIndex count);
+
+        /// Add a page to the free list. The page will be returned by a later call to GetNewPage.
+        /// @param index Index of the page. The page must not be used anymore.
+        /// @throw common::MkvDBException if the pager is read-only.
+        void FreePage(Page::PageIndex index);
+
+        /// Add a run of consecutive pages to the free list as a single extent. Only the first
+        /// page of the run is accessed. The extents are not merged with their neighbors.
+        /// @param first Index of the first page. The pages must not be used anymore.
+        /// @param count Number of pages.
+        /// @throw common::MkvDBException if the pager is read-only.
+        void FreePages(Page::PageIndex first, Page::PageIndex count);
+
+        /// Start loading pages in the background. The pages are read by a pool of I/O threads
+        /// while the caller continues its work. A later call to GetPage for one of these pages
+        /// finds it in the cache or waits for its read to complete. Pages that are already loaded
+        /// or that are not in the file are ignored.
+        ///
+        /// Pages prefetched with a sequential access hint are moved to the sequential ring, not
+        /// to the cache, when they are requested with the same hint. Those that are never
+        /// requested are dropped.
+        ///
+        /// The pages that are never requested are collected by the next writes of the modified
+        /// pages or, when too many of them are pending, by the next prefetches.
+        /// @param indexes Indexes of the pages that will be needed soon.
+        /// @param hint Indicates how the pages are going to be accessed.
+        void Prefetch(std::span<const Page::PageIndex> indexes,
+                      AccessHint hint = AccessHint::Normal);
+
+        /// Returns the maximum number of pages a sequential scan should have in flight ahead of
+        /// the page it reads. The pages read ahead of a sequential scan must not recycle each
+        /// other in the sequential ring before they are used.
+        Page::PageIndex sequential_window() const;
+
         /// Write on disk the pages that are modified.
+        /// @throw common::MkvDBException if the pager is read-only.
         void WriteModifiedPages();
 
+        /// Returns the number of pages in the pages cache. The pages held by the sequential
+        /// access ring are not included.
+        inline std::size_t cached_pages_count() const { return page_table_.size(); }
+
+        /// Returns the number of pages prefetched that were not requested yet.
+        inline std::size_t pending_reads_count() const { return pending_reads_.size(); }
+
+        /// Returns the statistics of the accesses to the pages, by NUMA node. When NUMA is
+        /// disabled, there is a single entry for all the accesses.
+        inline const std::vector<CacheStatistics>& statistics() const
+        {
+            return page_table_.statistics();
+        }
+
     private:
+        /// Total size of the frames used for sequential accesses.
+        static constexpr std::size_t SEQUENTIAL_RING_BYTES = 256 * 1024;
+
+        /// Minimum number of frames used for sequential accesses.
+        static constexpr std::size_t SEQUENTIAL_RING_MIN_FRAMES = 4;
+
+        /// Maximum amount of data read at once when a sequential run of pages is detected.
+        static constexpr std::size_t READAHEAD_MAX_BYTES = 1024 * 1024;
+
+        /// Number of threads used to read the pages that are prefetched.
+        static constexpr std::size_t PREFETCH_THREADS_COUNT = 4;
+
+        /// Maximum size of the pages prefetched and not requested yet. The pages that are never
+        /// requested are only released once their read is complete, so they are collected when
+        /// this size is reached.
+        static constexpr std::size_t PENDING_READS_MAX_BYTES = 4 * 1024 * 1024;
+
+        /// Maximum number of extents of the free list visited to find a run of new pages. Each
+        /// extent visited costs the read of its first page.
+        static constexpr std::size_t FREE_EXTENTS_SEARCH_LIMIT = 8;
+
+        /// Fields stored in the first page of an extent of the free list.
+        using NextFreeExtentField = common::Field<0, Page::PageIndex>;
+        using FreeExtentSizeField = common::NextField<NextFreeExtentField, Page::PageIndex>;
+
+        /// Page being loaded in the background.
+        struct PendingRead
+        {
+            std::shared_ptr<Page> page;
+            std::shared_future<void> done;
+            AccessHint hint;
+        };
+
+        /// Indicates if a page is in the cache, in the sequential ring or being loaded.
+        bool IsLoaded(Page::PageIndex index) const;
+
+        /// Returns the index of the first page that can't be read from the file. Pages that were
+        /// created but never written are not in the file yet.
+        Page::PageIndex ReadablePagesEnd() const;
+
+        /// Wait for a page loaded in the background and move it to the cache, or to the
+        /// sequential ring if it was both prefetched and requested for a sequential access.
+        std::shared_ptr<Page> CompletePendingRead(Page::PageIndex index, AccessHint hint);
+
+        /// Wait for all the pages loaded in the background and move them to the cache. The pages
+        /// that could not be read and the pages prefetched for a sequential access are dropped,
+        /// they will be read again if they are requested.
+        void CompletePendingReads();
+
+        /// Move the pages whose background read is complete to the cache, like
+        /// CompletePendingReads, without waiting for the other reads.
+        void CompleteFinishedReads();
+
+        /// Keep a page prefetched but not requested in the cache once its read is complete. The
+        /// page is dropped if its read failed or if it was prefetched for a sequential access.
+        void KeepPrefetchedPage(const PendingRead& pending);
+
+        /// Read a block of consecutive pages from a file. The references to the pages are
+        /// released when the function returns.
+        static void ReadBlock(fs::IFile& file,
+                              Page::PageSize page_size,
+                              std::vector<std::shared_ptr<Page>> pages);
+
+        /// Read a page from the file, along with the following pages if a sequential run is
+        /// detected.
+        std::shared_ptr<Page> ReadPages(Page::PageIndex index, AccessHint hint);
+
+        /// Returns the number of pages, starting at index, that can be read from the file in a
+        /// single block. The count is limited to the pages that exists in the file and that are
+        /// not already loaded.
+        Page::PageIndex CountReadablePages(Page::PageIndex index, Page::PageIndex max_count) const;
+
+        /// Returns a page taken from the free list. Its content is unspecified, so it is not read
+        /// from the file if it is not already loaded.
+        std::shared_ptr<Page> ReusePage(Page::PageIndex index);
+
+        /// Returns a frame where a page read from the file can be stored. The frame is registered
+        /// in the cache or in the sequential ring depending on the access hint.
+        std::shared_ptr<Page> CreateFrame(Page::PageIndex index, AccessHint hint);
+
+        /// Store a page in the sequential ring. The page of the ring that could not be dropped to
+        /// make room for it is kept in the cache.
+        void InsertInRing(std::shared_ptr<Page> page);
+
+        void WritePage(Page& page);
+
         fs::IFile& file_;
+        bool is_read_only_;
         std::optional<Header> header_;
         Page::PageSize page_size_;
-        std::unordered_map<Page::PageIndex, std::shared_ptr<Page>> pages_cache_;
+        std::endian byte_order_;
+        PageTable page_table_;
+        std::optional<PageRing> sequential_ring_;
+        std::optional<Readahead> readahead_;
+        std::vector<std::byte> readahead_buffer_;
+        std::unordered_map<Page::PageIndex, PendingRead> pending_reads_;
+
+        // The I/O threads use the file and the pages, so they must be stopped first.
+        std::unique_ptr<common::ThreadPool> io_threads_;
     };
 } // namespace mkvdb::pager
 
@@ -0,0 +1,40 @@
+#ifndef MKVDB_PAGER_READAHEAD_HPP_
+#define MKVDB_PAGER_READAHEAD_HPP_
+
+#include "mkvdb/pager/Page.hpp"
+
+namespace mkvdb::pager
+{
+    /// Detects sequential runs of page reads and computes how many pages should be read at once.
+    ///
+    /// Each time a page must be read from the file, the pager asks for a window. If the page
+    /// immediately follows the pages read previously, the reads are considered sequential and the
+    /// window is doubled, up to a maximum. Otherwise the window is reset to a single page. A read
+    /// of the header, page 0, never starts a sequential run.
+    class Readahead
+    {
+    public:
+        /// Constructor.
+        /// @param max_window Maximum number of pages read at once. Must be greater than zero.
+        Readahead(Page::PageIndex max_window);
+
+        /// Returns the current size of the window.
+        inline Page::PageIndex window() const { return window_; }
+
+        /// Register a read of the file and returns the number of pages that should be read.
+        /// @param index Index of the first page that must be read.
+        Page::PageIndex OnRead(Page::PageIndex index);
+
+        /// Register the number of pages that were actually read by the last read.
+        /// @param index Index of the first page that was read.
+        /// @param count Number of pages that were read.
+        void OnPagesRead(Page::PageIndex index, Page::PageIndex count);
+
+    private:
+        Page::PageIndex max_window_;
+        Page::PageIndex window_;
+        Page::PageIndex next_index_;
+    };
+} // namespace mkvdb::pager
+
+#endif // MKVDB_PAGER_READAHEAD_HPP_
\ No newline at end of file
@@ -0,0 +1,905 @@
+#include "mkvdb/btree/BTree.hpp"
+
+#include "mkvdb/btree/Cell.hpp"
+#include "mkvdb/btree/Key.hpp"
+#include "mkvdb/btree/OverflowReference.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Serialization.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+namespace mkvdb::btree
+{
+    pager::Page::PageIndex BTree::Create(pager::Pager& pager)
+    {
+        auto page = pager.GetNewPage();
+        Node(*page).InitializeNewNode(NodeHeader::NodeType::Leaf);
+        return page->index();
+    }
+
+    BTree::BTree(pager::Pager& pager, pager::Page::PageIndex root_index)
+    : pager_(pager),
+      root_index_(root_index)
+    {
+        auto content_size   = pager_.GetPage(root_index_)->content().size();
+        max_key_value_size_ = MaxKeyValueSize(content_size);
+        max_key_size_       = MaxKeySize(content_size);
+    }
+
+    common::ValueSize BTree::MaxKeyValueSize(common::FileOffset content_size)
+    {
+        return Node::MaxCellSize(content_size) - Cell::CalculateRequiredSize(0, 0);
+    }
+
+    common::ValueSize BTree::MaxKeySize(common::FileOffset content_size)
+    {
+        // A key must leave room in its cell for a child index or for an overflow reference.
+        return MaxKeyValueSize(content_size) - OverflowReference::REFERENCE_SIZE;
+    }
+
+    std::size_t BTree::height() const
+    {
+        std::size_t height = 1;
+
+        auto page = pager_.GetPage(root_index_);
+        while(!Node(*page).is_leaf())
+        {
+            page = pager_.GetPage(Node(*page).ChildAt(0));
+            ++height;
+        }
+
+        return height;
+    }
+
+    std::optional<std::vector<std::byte>> BTree::Get(common::ConstByteSpan key) const
+    {
+        auto page = FindLeaf(key, nullptr);
+        Node leaf(*page);
+
+        auto result = leaf.Find(key);
+        if(!result.found)
+        {
+            return std::nullopt;
+        }
+
+        auto value = leaf.ValueAt(result.position);
+        if(leaf.HasOverflowAt(result.position))
+        {
+            ValueReader reader(pager_, value, true);
+            std::vector<std::byte> whole_value(reader.size());
+            reader.Read(whole_value);
+            return whole_value;
+        }
+        return std::vector<std::byte>(value.begin(), value.end());
+    }
+
+    std::vector<std::optional<std::vector<std::byte>>>
+      BTree::MultiGet(std::span<const common::ConstByteSpan> keys) const
+    {
+        std::vector<std::optional<std::vector<std::byte>>> values(keys.size());
+
+        std::vector<std::size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(),
+                  order.end(),
+                  [&keys](std::size_t lhs, std::size_t rhs)
+                  { return CompareKeys(keys[lhs], keys[rhs]) < 0; });
+
+        // Nodes of the current level with the range of sorted keys that lead to each of them.
+        struct Visit
+        {
+            std::shared_ptr<pager::Page> page;
+            std::size_t begin;
+            std::size_t end;
+        };
+        std::vector<Visit> visits;
+        if(!keys.empty())
+        {
+            visits.push_back({ pager_.GetPage(root_index_), 0, keys.size() });
+        }
+
+        std::vector<Visit> children;
+        std::vector<pager::Page::PageIndex> indexes;
+        std::vector<std::byte> separator;
+        while(!visits.empty() && !Node(*visits.front().page).is_leaf())
+        {
+            // The keys of a range going to the same child are grouped by comparing them with the
+            // separator after the child, so a node is searched once per child rather than once per
+            // key.
+            children.clear();
+            indexes.clear();
+            for(const auto& visit : visits)
+            {
+                Node node(*visit.page);
+                for(auto i = visit.begin; i < visit.end;)
+                {
+                    auto position = node.FindChildPosition(keys[order[i]]);
+                    auto last     = i + 1;
+                    if(position < node.size())
+                    {
+                        node.CopyKeyAt(position, separator);
+                        while(last < visit.end && CompareKeys(keys[order[last]], separator) < 0)
+                        {
+                            ++last;
+                        }
+                    }
+                    else
+                    {
+                        last = visit.end;
+                    }
+
+                    indexes.push_back(node.ChildAt(position));
+                    children.push_back({ nullptr, i, last });
+                    i = last;
+                }
+            }
+
+            // All the children are requested before any of them is read, so their reads overlap.
+            pager_.Prefetch(indexes);
+            for(std::size_t i = 0; i < children.size(); ++i)
+            {
+                children[i].page = pager_.GetPage(indexes[i]);
+            }
+            std::swap(visits, children);
+        }
+
+        for(const auto& visit : visits)
+        {
+            Node leaf(*visit.page);
+            for(auto i = visit.begin; i < visit.end; ++i)
+            {
+                auto result = leaf.Find(keys[order[i]]);
+                if(!result.found)
+                {
+                    continue;
+                }
+
+                auto value = leaf.ValueAt(result.position);
+                auto& out  = values[order[i]].emplace();
+                if(leaf.HasOverflowAt(result.position))
+                {
+                    ValueReader reader(pager_, value, true);
+                    out.resize(reader.size());
+                    reader.Read(out);
+                }
+                else
+                {
+                    out.assign(value.begin(), value.end());
+                }
+            }
+        }
+
+        return values;
+    }
+
+    void BTree::Put(common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        if(key.size() > max_key_size_)
+        {
+            throw common::MkvDBException("The key is too large.");
+        }
+        if(key.size() + value.size() > max_key_value_size_)
+        {
+            auto writer = OpenValueWriter(key, value.size());
+            writer.Write(value);
+            writer.Commit();
+            return;
+        }
+
+        PutCell(key, value, false);
+    }
+
+    std::optional<ValueReader> BTree::OpenValueReader(common::ConstByteSpan key) const
+    {
+        auto page = FindLeaf(key, nullptr);
+        Node leaf(*page);
+
+        auto result = leaf.Find(key);
+        if(!result.found)
+        {
+            return std::nullopt;
+        }
+
+        return ValueReader(
+          pager_, leaf.ValueAt(result.position), leaf.HasOverflowAt(result.position));
+    }
+
+    ValueWriter BTree::OpenValueWriter(common::ConstByteSpan key, common::FileOffset value_size)
+    {
+        return ValueWriter(*this, key, value_size);
+    }
+
+    bool BTree::Delete(common::ConstByteSpan key)
+    {
+        std::vector<PathEntry> path;
+        auto page = FindLeaf(key, &path);
+        Node leaf(*page);
+
+        auto result = leaf.Find(key);
+        if(!result.found)
+        {
+            return false;
+        }
+
+        if(leaf.HasOverflowAt(result.position))
+        {
+            FreeOverflow(leaf.ValueAt(result.position));
+        }
+        leaf.Erase(result.position);
+
+        if(!path.empty() && IsUnderflowing(leaf))
+        {
+            Rebalance(path, std::move(page));
+        }
+        return true;
+    }
+
+    void BTree::Write(const WriteBatch& batch)
+    {
+        if(pager_.is_read_only())
+        {
+            throw common::MkvDBException("Cannot write the batch, the pager is read-only.");
+        }
+        for(std::size_t i = 0; i < batch.size(); ++i)
+        {
+            if(batch.key(i).size() > max_key_size_)
+            {
+                throw common::MkvDBException("The key is too large.");
+            }
+            if(batch.value(i).size() > UINT32_MAX)
+            {
+                throw common::MkvDBException("The value is too large.");
+            }
+        }
+
+        // Sorted operations visit the leaves in order, so consecutive operations mostly find their
+        // pages in the cache. The sort is stable to keep the operations on a key in their order.
+        std::vector<std::size_t> order(batch.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(),
+                         order.end(),
+                         [&batch](std::size_t lhs, std::size_t rhs)
+                         { return CompareKeys(batch.key(lhs), batch.key(rhs)) < 0; });
+
+        for(std::size_t i = 0; i < order.size(); ++i)
+        {
+            auto pos = order[i];
+            if(i + 1 < order.size() && CompareKeys(batch.key(pos), batch.key(order[i + 1])) == 0)
+            {
+                continue;
+            }
+
+            if(batch.type(pos) == WriteBatch::OperationType::Put)
+            {
+                Put(batch.key(pos), batch.value(pos));
+            }
+            else
+            {
+                Delete(batch.key(pos));
+            }
+        }
+
+        pager_.WriteModifiedPages();
+    }
+
+    std::shared_ptr<pager::Page> BTree::FindLeaf(common::ConstByteSpan key,
+                                                 std::vector<PathEntry>* path) const
+    {
+        auto page = pager_.GetPage(root_index_);
+        for(;;)
+        {
+            Node node(*page);
+            if(node.is_leaf())
+            {
+                return page;
+            }
+
+            auto position = node.FindChildPosition(key);
+            if(path)
+            {
+                path->push_back({ page, position });
+            }
+            page = pager_.GetPage(node.ChildAt(position));
+        }
+    }
+
+    void BTree::PutCell(common::ConstByteSpan key, common::ConstByteSpan value, bool has_overflow)
+    {
+        // A key greater than all the keys of the rightmost leaf goes at its end, so appends skip
+        // the descent from the root.
+        std::vector<PathEntry> path;
+        std::shared_ptr<pager::Page> page;
+        if(append_leaf_ && IsAfterLastKey(Node(*append_leaf_), key))
+        {
+            path = append_path_;
+            page = append_leaf_;
+        }
+        else
+        {
+            page = FindLeaf(key, &path);
+            bool is_rightmost = std::all_of(path.begin(),
+                                            path.end(),
+                                            [](const PathEntry& entry)
+                                            { return entry.position == Node(*entry.page).size(); });
+            if(is_rightmost)
+            {
+                append_path_ = path;
+                append_leaf_ = page;
+            }
+        }
+        Node leaf(*page);
+
+        auto result = leaf.Find(key);
+        if(result.found)
+        {
+            auto old_value = leaf.ValueAt(result.position);
+            if(leaf.HasOverflowAt(result.position))
+            {
+                FreeOverflow(old_value);
+            }
+            else if(!has_overflow && old_value.size() == value.size())
+            {
+                leaf.ReplaceValue(result.position, value);
+                return;
+            }
+            leaf.Erase(result.position);
+        }
+
+        InsertCell(path, std::move(page), result.position, key, value, has_overflow);
+    }
+
+    void BTree::InsertCell(std::vector<PathEntry>& path,
+                           std::shared_ptr<pager::Page> page,
+                           NodeHeader::NodeSize pos,
+                           common::ConstByteSpan key,
+                           common::ConstByteSpan value,
+                           bool has_overflow)
+    {
+        std::vector<std::byte> separator;
+        std::array<std::byte, sizeof(pager::Page::PageIndex)> child;
+
+        for(;;)
+        {
+            Node node(*page);
+            if(node.CanInsert(key.size(), value.size()))
+            {
+                node.Insert(pos, key, value, has_overflow);
+                return;
+            }
+
+            // The path cached for the appends goes through the nodes that are about to change.
+            append_path_.clear();
+            append_leaf_.reset();
+
+            if(path.empty())
+            {
+                auto new_child = GrowRoot(*page);
+                path.push_back({ std::move(page), 0 });
+                page = std::move(new_child);
+                continue;
+            }
+
+            auto split  = Split(node, FindFences(path), pos, key, value, has_overflow);
+            auto parent = std::move(path.back());
+            path.pop_back();
+
+            // The node now holds the keys lower than the separator, so the parent pointer that used
+            // to designate it moves to the new right sibling and a cell pointing to the node is
+            // inserted before it.
+            Node(*parent.page).SetChildAt(parent.position, split.right->index());
+
+            separator = std::move(split.separator);
+            common::Serialize(page->index(), child);
+
+            key          = separator;
+            value        = child;
+            has_overflow = false;
+            page         = std::move(parent.page);
+            pos          = parent.position;
+        }
+    }
+
+    std::shared_ptr<pager::Page> BTree::GrowRoot(pager::Page& root)
+    {
+        auto child   = pager_.GetNewPage();
+        auto content = root.content();
+        assert(content.size() == child->content().size());
+
+        std::copy(content.begin(), content.end(), child->content().begin());
+        child->MarkAsModified();
+
+        Node node(root);
+        node.InitializeNewNode(NodeHeader::NodeType::Inner);
+        node.SetChildAt(0, child->index());
+
+        return child;
+    }
+
+    bool BTree::IsAfterLastKey(const Node& leaf, common::ConstByteSpan key)
+    {
+        if(leaf.size() == 0)
+        {
+            return false;
+        }
+
+        auto prefix = leaf.prefix();
+        auto order  = CompareKeys(key.first(std::min(key.size(), prefix.size())), prefix);
+        if(order != 0)
+        {
+            return order > 0;
+        }
+        return CompareKeys(key.subspan(prefix.size()), leaf.SuffixAt(leaf.size() - 1)) > 0;
+    }
+
+    BTree::Fences BTree::FindFences(const std::vector<PathEntry>& path)
+    {
+        // The nearest ancestors give the tightest fences.
+        Fences fences;
+        for(auto it = path.rbegin(); it != path.rend() && (!fences.lower || !fences.upper); ++it)
+        {
+            Node parent(*it->page);
+            if(!fences.lower && it->position > 0)
+            {
+                parent.CopyKeyAt(it->position - 1, fences.lower.emplace());
+            }
+            if(!fences.upper && it->position < parent.size())
+            {
+                parent.CopyKeyAt(it->position, fences.upper.emplace());
+            }
+        }
+
+        return fences;
+    }
+
+    BTree::SplitResult BTree::Split(Node& node,
+                                    const Fences& fences,
+                                    NodeHeader::NodeSize pos,
+                                    common::ConstByteSpan key,
+                                    common::ConstByteSpan value,
+                                    bool has_overflow)
+    {
+        // Work on a copy of the node so the cells stay readable while the node is rebuilt.
+        auto& page = node.page();
+        pager::Page copy(page.index(), page.size());
+        copy.SetByteOrder(page.byte_order());
+        std::copy(page.data().begin(), page.data().end(), copy.data().begin());
+        Node source(copy);
+
+        // The keys are rebuilt from the prefix and the suffixes of the cells, because each half
+        // gets a new prefix.
+        std::vector<std::byte> keys;
+        std::vector<std::size_t> keys_ends;
+        std::vector<common::ConstByteSpan> values;
+        std::vector<bool> overflows;
+        std::vector<std::byte> cell_key;
+        for(NodeHeader::NodeSize i = 0; i <= source.size(); ++i)
+        {
+            if(i == pos)
+            {
+                keys.insert(keys.end(), key.begin(), key.end());
+                keys_ends.push_back(keys.size());
+                values.push_back(value);
+                overflows.push_back(has_overflow);
+            }
+            if(i < source.size())
+            {
+                source.CopyKeyAt(i, cell_key);
+                keys.insert(keys.end(), cell_key.begin(), cell_key.end());
+                keys_ends.push_back(keys.size());
+                values.push_back(source.ValueAt(i));
+                overflows.push_back(source.HasOverflowAt(i));
+            }
+        }
+
+        // lower_sizes[i] is the size of the cells before position i.
+        std::vector<std::pair<common::ConstByteSpan, common::ConstByteSpan>> cells;
+        std::vector<common::FileOffset> lower_sizes(1, 0);
+        cells.reserve(values.size());
+        for(std::size_t i = 0; i < values.size(); ++i)
+        {
+            auto begin = i == 0 ? 0 : keys_ends[i - 1];
+            cells.emplace_back(common::ConstByteSpan(keys).subspan(begin, keys_ends[i] - begin),
+                               values[i]);
+            lower_sizes.push_back(lower_sizes.back()
+                                  + Cell::CalculateRequiredSize(
+                                    cells[i].first.size() - source.prefix().size(),
+                                    cells[i].second.size())
+                                  + SlotArray::SLOT_SIZE);
+        }
+        auto total_size = lower_sizes.back();
+
+        // Find the middle of the cells by size. In an inner node the cell at the middle is pushed
+        // up to the parent, so it must be followed by at least one cell.
+        //
+        // A cell added after the last cell of the rightmost node of a level is most likely an
+        // append of increasing keys. The node then keeps all its cells and the new right sibling
+        // starts with the new cell, so the nodes filled by appends stay full instead of half
+        // empty. The node fits its cells since its prefix can only grow: a node without an upper
+        // fence has no prefix.
+        bool is_leaf   = source.is_leaf();
+        bool is_append = !fences.upper && pos == source.size();
+        assert(cells.size() >= (is_leaf ? 2 : 3));
+        std::size_t middle = 0;
+        if(is_append)
+        {
+            middle = cells.size() - (is_leaf ? 1 : 2);
+        }
+        else
+        {
+            while(lower_sizes[middle] < total_size / 2)
+            {
+                ++middle;
+            }
+            middle = std::clamp<std::size_t>(middle, 1, cells.size() - (is_leaf ? 1 : 2));
+        }
+
+        std::vector<std::byte> separator;
+        if(is_leaf && is_append)
+        {
+            auto size = ShortestSeparatorSize(cells[middle - 1].first, cells[middle].first);
+            auto key_prefix = cells[middle].first.first(size);
+            separator.assign(key_prefix.begin(), key_prefix.end());
+        }
+        else if(is_leaf)
+        {
+            // The separator of a leaf only needs to be greater than the last key of the left half
+            // and smaller or equal to the first key of the right half, so it is truncated to the
+            // shortest such prefix of the first key of the right half. The split point is moved
+            // within a window around the middle to find the shortest separator, as long as both
+            // halves fit in a node.
+            auto capacity =
+              page.content().size() - NodeHeader::HEADER_SIZE - source.prefix().size();
+            auto window = std::max<std::size_t>(1, cells.size() / SEPARATOR_WINDOW_DIVISOR);
+            auto first  = middle > window ? middle - window : 1;
+            auto last   = std::min(middle + window, cells.size() - 1);
+
+            auto separator_size = [&](std::size_t i)
+            { return ShortestSeparatorSize(cells[i - 1].first, cells[i].first); };
+            auto best_size = separator_size(middle);
+            for(auto i = first; i <= last; ++i)
+            {
+                auto size = separator_size(i);
+                if(size < best_size && lower_sizes[i] <= capacity
+                   && total_size - lower_sizes[i] <= capacity)
+                {
+                    middle    = i;
+                    best_size = size;
+                }
+            }
+
+            auto key_prefix = cells[middle].first.first(best_size);
+            separator.assign(key_prefix.begin(), key_prefix.end());
+        }
+        else
+        {
+            separator.assign(cells[middle].first.begin(), cells[middle].first.end());
+        }
+
+        // Each half is bounded by the separator on one side and by a fence of the node on the
+        // other side. A half without a fence is at the edge of the tree and gets no prefix.
+        common::ConstByteSpan left_prefix;
+        if(fences.lower)
+        {
+            left_prefix =
+              common::ConstByteSpan(separator).first(CommonPrefixSize(*fences.lower, separator));
+        }
+        common::ConstByteSpan right_prefix;
+        if(fences.upper)
+        {
+            right_prefix =
+              common::ConstByteSpan(separator).first(CommonPrefixSize(separator, *fences.upper));
+        }
+
+        auto right_page = pager_.GetNewPage();
+        Node right(*right_page);
+        right.InitializeNewNode(source.type(), right_prefix);
+        node.InitializeNewNode(source.type(), left_prefix);
+
+        for(std::size_t i = 0; i < middle; ++i)
+        {
+            node.Insert(node.size(), cells[i].first, cells[i].second, overflows[i]);
+        }
+
+        if(is_leaf)
+        {
+            for(std::size_t i = middle; i < cells.size(); ++i)
+            {
+                right.Insert(right.size(), cells[i].first, cells[i].second, overflows[i]);
+            }
+
+            // The new leaf is linked between the node and its former right sibling.
+            node.SetLeftSibling(source.left_sibling());
+            node.SetRightSibling(right_page->index());
+            right.SetLeftSibling(page.index());
+            right.SetRightSibling(source.right_sibling());
+            if(source.right_sibling() != 0)
+            {
+                Node(*pager_.GetPage(source.right_sibling())).SetLeftSibling(right_page->index());
+            }
+        }
+        else
+        {
+            node.SetChildAt(node.size(),
+                            common::Deserialize<pager::Page::PageIndex>(cells[middle].second));
+            for(std::size_t i = middle + 1; i < cells.size(); ++i)
+            {
+                right.Insert(right.size(), cells[i].first, cells[i].second);
+            }
+            right.SetChildAt(right.size(), source.right_child());
+        }
+
+        return { std::move(separator), std::move(right_page) };
+    }
+
+    bool BTree::IsUnderflowing(const Node& node)
+    {
+        auto capacity = node.page().content().size() - NodeHeader::HEADER_SIZE;
+        return capacity - node.free_space() < capacity / UNDERFLOW_DIVISOR;
+    }
+
+    void BTree::Rebalance(std::vector<PathEntry>& path, std::shared_ptr<pager::Page> page)
+    {
+        // The path cached for the appends goes through the nodes that are about to change.
+        append_path_.clear();
+        append_leaf_.reset();
+
+        // Each merge removes a cell from the parent, which may underflow in turn.
+        while(!path.empty() && IsUnderflowing(Node(*page)))
+        {
+            auto parent = std::move(path.back());
+            path.pop_back();
+
+            // A node that is the only child of its parent has no sibling to merge with. It is
+            // left as it is until its parent is merged with a sibling of its own.
+            Node parent_node(*parent.page);
+            if(parent_node.size() == 0)
+            {
+                page = std::move(parent.page);
+                continue;
+            }
+
+            // The node is paired with its right sibling, or with its left sibling if it is the
+            // rightmost child.
+            std::shared_ptr<pager::Page> left;
+            std::shared_ptr<pager::Page> right;
+            auto position = parent.position;
+            if(position < parent_node.size())
+            {
+                left  = std::move(page);
+                right = pager_.GetPage(parent_node.ChildAt(position + 1));
+            }
+            else
+            {
+                --position;
+                left  = pager_.GetPage(parent_node.ChildAt(position));
+                right = std::move(page);
+            }
+
+            if(!MergeOrBorrow(path, parent.page, position, *left, *right))
+            {
+                return;
+            }
+            page = std::move(parent.page);
+        }
+
+        // The root loses its last cell when its last two children are merged. The remaining
+        // child then moves to the root page, which makes the tree shorter.
+        if(path.empty())
+        {
+            Node root(*page);
+            while(!root.is_leaf() && root.size() == 0)
+            {
+                auto child   = pager_.GetPage(root.right_child());
+                auto content = child->content();
+                std::copy(content.begin(), content.end(), page->content().begin());
+                page->MarkAsModified();
+                pager_.FreePage(child->index());
+            }
+        }
+    }
+
+    bool BTree::MergeOrBorrow(std::vector<PathEntry>& path,
+                              std::shared_ptr<pager::Page> parent_page,
+                              NodeHeader::NodeSize position,
+                              pager::Page& left_page,
+                              pager::Page& right_page)
+    {
+        Node parent(*parent_page);
+
+        // The pair of nodes is bounded by the keys of the parent around the separator, or by the
+        // fences of the parent at its edges.
+        auto fences = FindFences(path);
+        if(position > 0)
+        {
+            parent.CopyKeyAt(position - 1, fences.lower.emplace());
+        }
+        if(position + 1 < parent.size())
+        {
+            parent.CopyKeyAt(position + 1, fences.upper.emplace());
+        }
+        std::vector<std::byte> separator;
+        parent.CopyKeyAt(position, separator);
+
+        common::ConstByteSpan prefix;
+        if(fences.lower && fences.upper)
+        {
+            prefix = common::ConstByteSpan(*fences.lower)
+                       .first(CommonPrefixSize(*fences.lower, *fences.upper));
+        }
+
+        // Work on copies of the nodes so the cells stay readable while the nodes are rebuilt.
+        pager::Page left_copy(left_page.index(), left_page.size());
+        left_copy.SetByteOrder(left_page.byte_order());
+        std::copy(left_page.data().begin(), left_page.data().end(), left_copy.data().begin());
+        pager::Page right_copy(right_page.index(), right_page.size());
+        right_copy.SetByteOrder(right_page.byte_order());
+        std::copy(right_page.data().begin(), right_page.data().end(), right_copy.data().begin());
+        Node left_source(left_copy);
+        Node right_source(right_copy);
+        bool is_leaf = left_source.is_leaf();
+
+        // The cells of both nodes are gathered with their whole keys. In inner nodes the
+        // separator comes down between them, pointing to the rightmost child of the left node.
+        std::vector<std::byte> keys;
+        std::vector<std::size_t> keys_ends;
+        std::vector<common::ConstByteSpan> values;
+        std::vector<bool> overflows;
+        std::vector<std::byte> cell_key;
+        auto gather = [&](const Node& source)
+        {
+            for(NodeHeader::NodeSize i = 0; i < source.size(); ++i)
+            {
+                source.CopyKeyAt(i, cell_key);
+                keys.insert(keys.end(), cell_key.begin(), cell_key.end());
+                keys_ends.push_back(keys.size());
+                values.push_back(source.ValueAt(i));
+                overflows.push_back(source.HasOverflowAt(i));
+            }
+        };
+        std::array<std::byte, sizeof(pager::Page::PageIndex)> left_child;
+        gather(left_source);
+        if(!is_leaf)
+        {
+            common::Serialize(left_source.right_child(), left_child);
+            keys.insert(keys.end(), separator.begin(), separator.end());
+            keys_ends.push_back(keys.size());
+            values.push_back(left_child);
+            overflows.push_back(false);
+        }
+        gather(right_source);
+
+        // lower_sizes[i] is the size of the cells before position i, with the prefix shared by
+        // the fences. Each node of the pair has at least this prefix.
+        std::vector<std::pair<common::ConstByteSpan, common::ConstByteSpan>> cells;
+        std::vector<common::FileOffset> lower_sizes(1, 0);
+        cells.reserve(values.size());
+        for(std::size_t i = 0; i < values.size(); ++i)
+        {
+            auto begin = i == 0 ? 0 : keys_ends[i - 1];
+            cells.emplace_back(common::ConstByteSpan(keys).subspan(begin, keys_ends[i] - begin),
+                               values[i]);
+            lower_sizes.push_back(
+              lower_sizes.back()
+              + Cell::CalculateRequiredSize(cells[i].first.size() - prefix.size(),
+                                            cells[i].second.size())
+              + SlotArray::SLOT_SIZE);
+        }
+        auto total_size = lower_sizes.back();
+
+        Node left(left_page);
+        Node right(right_page);
+        auto capacity = left_page.content().size() - NodeHeader::HEADER_SIZE;
+        if(prefix.size() + total_size <= capacity * MERGE_LIMIT_PERCENT / 100)
+        {
+            // The right node is merged into the left node and its page is freed.
+            left.InitializeNewNode(left_source.type(), prefix);
+            for(std::size_t i = 0; i < cells.size(); ++i)
+            {
+                left.Insert(left.size(), cells[i].first, cells[i].second, overflows[i]);
+            }
+
+            if(is_leaf)
+            {
+                left.SetLeftSibling(left_source.left_sibling());
+                left.SetRightSibling(right_source.right_sibling());
+                if(right_source.right_sibling() != 0)
+                {
+                    Node(*pager_.GetPage(right_source.right_sibling()))
+                      .SetLeftSibling(left_page.index());
+                }
+            }
+            else
+            {
+                left.SetChildAt(left.size(), right_source.right_child());
+            }
+
+            // The child pointer that followed the separator designated the right node.
+            parent.Erase(position);
+            parent.SetChildAt(position, left_page.index());
+            pager_.FreePage(right_page.index());
+            return true;
+        }
+
+        // The nodes are too full to merge, so the cells are shared evenly between them. In an
+        // inner node the cell at the middle is pushed up to the parent, so it must be followed by
+        // at least one cell.
+        assert(cells.size() >= (is_leaf ? 2 : 3));
+        std::size_t middle = 0;
+        while(lower_sizes[middle] < total_size / 2)
+        {
+            ++middle;
+        }
+        middle = std::clamp<std::size_t>(middle, 1, cells.size() - (is_leaf ? 1 : 2));
+
+        auto separator_size = cells[middle].first.size();
+        if(is_leaf)
+        {
+            separator_size = ShortestSeparatorSize(cells[middle - 1].first, cells[middle].first);
+        }
+        auto new_separator = cells[middle].first.first(separator_size);
+        separator.assign(new_separator.begin(), new_separator.end());
+
+        common::ConstByteSpan left_prefix;
+        if(fences.lower)
+        {
+            left_prefix =
+              common::ConstByteSpan(separator).first(CommonPrefixSize(*fences.lower, separator));
+        }
+        common::ConstByteSpan right_prefix;
+        if(fences.upper)
+        {
+            right_prefix =
+              common::ConstByteSpan(separator).first(CommonPrefixSize(separator, *fences.upper));
+        }
+
+        left.InitializeNewNode(left_source.type(), left_prefix);
+        right.InitializeNewNode(right_source.type(), right_prefix);
+        for(std::size_t i = 0; i < middle; ++i)
+        {
+            left.Insert(left.size(), cells[i].first, cells[i].second, overflows[i]);
+        }
+
+        if(is_leaf)
+        {
+            for(std::size_t i = middle; i < cells.size(); ++i)
+            {
+                right.Insert(right.size(), cells[i].first, cells[i].second, overflows[i]);
+            }
+            left.SetLeftSibling(left_source.left_sibling());
+            left.SetRightSibling(right_page.index());
+            right.SetLeftSibling(left_page.index());
+            right.SetRightSibling(right_source.right_sibling());
+        }
+        else
+        {
+            left.SetChildAt(left.size(),
+                            common::Deserialize<pager::Page::PageIndex>(cells[middle].second));
+            for(std::size_t i = middle + 1; i < cells.size(); ++i)
+            {
+                right.Insert(right.size(), cells[i].first, cells[i].second);
+            }
+            right.SetChildAt(right.size(), right_source.right_child());
+        }
+
+        // The new separator replaces the old one. It may be longer, so inserting it may split the
+        // parent.
+        std::array<std::byte, sizeof(pager::Page::PageIndex)> child;
+        common::Serialize(left_page.index(), child);
+        parent.Erase(position);
+        InsertCell(path, std::move(parent_page), position, separator, child, false);
+        return false;
+    }
+
+    void BTree::FreeOverflow(common::ConstByteSpan cell_value)
+    {
+        OverflowReference reference(cell_value);
+        auto count = OverflowReference::CountPages(reference.overflow_size(), pager_.page_size());
+        pager_.FreePages(reference.first_page(), count);
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "mkvdb/btree/BulkLoader.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/Cell.hpp"
+#include "mkvdb/btree/Key.hpp"
+#include "mkvdb/btree/Node.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Serialization.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+
+namespace mkvdb::btree
+{
+    BulkLoader::BulkLoader(pager::Pager& pager, double fill_factor)
+    : pager_(pager),
+      last_leaf_(0),
+      levels_(1)
+    {
+        assert(0.5 <= fill_factor && fill_factor <= 1);
+
+        // The content of a page is the whole page, so the limits are the limits of the tree.
+        auto page_size      = pager_.page_size();
+        max_key_value_size_ = BTree::MaxKeyValueSize(page_size);
+        max_key_size_       = BTree::MaxKeySize(page_size);
+        fill_size_ =
+          static_cast<common::FileOffset>((page_size - NodeHeader::HEADER_SIZE) * fill_factor);
+    }
+
+    void BulkLoader::Add(common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        if(key.size() > max_key_size_)
+        {
+            throw common::MkvDBException("The key is too large.");
+        }
+        if(key.size() + value.size() > max_key_value_size_)
+        {
+            throw common::MkvDBException("The key/value pair is too large.");
+        }
+
+        auto& leaf = levels_.front();
+        if(!leaf.cells.empty())
+        {
+            auto last_key = leaf.KeyAt(leaf.cells.size() - 1);
+            if(CompareKeys(last_key, key) >= 0)
+            {
+                throw common::MkvDBException("The keys must be added in increasing order.");
+            }
+
+            if(!Fits(leaf, key.size(), value.size()))
+            {
+                // The separator only needs to be greater than the last key of the leaf and smaller
+                // or equal to the new key, so it is truncated like the separators of the splits.
+                auto separator_size = ShortestSeparatorSize(last_key, key);
+                std::vector<std::byte> separator(key.begin(), key.begin() + separator_size);
+
+                auto index       = CloseNode(leaf, NodeHeader::NodeType::Leaf, separator);
+                auto lower_fence = std::move(leaf.lower_fence);
+                leaf.lower_fence = std::move(separator);
+                AddChild(1, std::move(lower_fence), index);
+            }
+        }
+
+        levels_.front().Append(key, value);
+    }
+
+    pager::Page::PageIndex BulkLoader::Finish()
+    {
+        auto& leaf = levels_.front();
+        if(leaf.cells.empty())
+        {
+            auto page = pager_.GetNewPage();
+            Node(*page).InitializeNewNode(NodeHeader::NodeType::Leaf);
+            return page->index();
+        }
+
+        // Complete the last node of each level from the bottom up. The node completed at the
+        // highest level is the root.
+        std::optional<pager::Page::PageIndex> index;
+        std::optional<std::vector<std::byte>> lower_fence;
+        for(std::size_t i = 0; i < levels_.size(); ++i)
+        {
+            if(index)
+            {
+                AddChild(i, std::move(lower_fence), *index);
+            }
+
+            auto& level = levels_[i];
+            auto type   = i == 0 ? NodeHeader::NodeType::Leaf : NodeHeader::NodeType::Inner;
+            if(i + 1 == levels_.size() && type == NodeHeader::NodeType::Inner
+               && level.cells.empty() && !level.previous_index)
+            {
+                // The highest level has a single child, it is the root.
+                return *level.right_child;
+            }
+
+            if(BalanceLastNodes(level, type))
+            {
+                // The parent level already holds the previous node as its last child.
+                index.reset();
+                continue;
+            }
+
+            index       = CloseNode(level, type, std::nullopt);
+            lower_fence = std::move(level.lower_fence);
+        }
+
+        return *index;
+    }
+
+    common::ConstByteSpan BulkLoader::Level::KeyAt(std::size_t pos) const
+    {
+        return common::ConstByteSpan(data).subspan(cells[pos].offset, cells[pos].key_size);
+    }
+
+    void BulkLoader::Level::Append(common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        cells.push_back({ data.size(), key.size(), value.size() });
+        data.insert(data.end(), key.begin(), key.end());
+        data.insert(data.end(), value.begin(), value.end());
+        used_size += Cell::CalculateRequiredSize(key.size(), value.size()) + SlotArray::SLOT_SIZE;
+    }
+
+    bool BulkLoader::Fits(const Level& level,
+                          common::FileOffset key_size,
+                          common::FileOffset value_size) const
+    {
+        // The size of a cell is counted with its whole key, so the prefix of the node can only
+        // leave more free space.
+        auto size = Cell::CalculateRequiredSize(key_size, value_size) + SlotArray::SLOT_SIZE;
+        return level.used_size + size <= fill_size_;
+    }
+
+    void BulkLoader::AddChild(std::size_t level_index,
+                              std::optional<std::vector<std::byte>> separator,
+                              pager::Page::PageIndex child)
+    {
+        if(level_index == levels_.size())
+        {
+            levels_.emplace_back();
+        }
+
+        auto& level = levels_[level_index];
+        if(!level.right_child)
+        {
+            level.lower_fence = std::move(separator);
+            level.right_child = child;
+            return;
+        }
+
+        // The previous child becomes the child of a cell whose key is the separator of the new
+        // child, unless the node is full. Then the separator is pushed up to the parent level.
+        assert(separator);
+        if(!Fits(level, separator->size(), sizeof(pager::Page::PageIndex)))
+        {
+            auto index        = CloseNode(level, NodeHeader::NodeType::Inner, *separator);
+            auto lower_fence  = std::move(level.lower_fence);
+            level.lower_fence = std::move(separator);
+            level.right_child = child;
+            AddChild(level_index + 1, std::move(lower_fence), index);
+            return;
+        }
+
+        std::array<std::byte, sizeof(pager::Page::PageIndex)> previous_child;
+        common::Serialize(*level.right_child, previous_child);
+        level.Append(*separator, previous_child);
+        level.right_child = child;
+    }
+
+    pager::Page::PageIndex BulkLoader::CloseNode(Level& level,
+                                                 NodeHeader::NodeType type,
+                                                 std::optional<common::ConstByteSpan> upper_fence)
+    {
+        common::ConstByteSpan prefix;
+        if(level.lower_fence && upper_fence)
+        {
+            prefix = common::ConstByteSpan(*level.lower_fence)
+                       .first(CommonPrefixSize(*level.lower_fence, *upper_fence));
+        }
+
+        auto page = pager_.GetNewPage();
+        WriteNode(*page, level, type, upper_fence);
+        if(type == NodeHeader::NodeType::Leaf)
+        {
+            if(last_leaf_ != 0)
+            {
+                Node(*page).SetLeftSibling(last_leaf_);
+                Node(*pager_.GetPage(last_leaf_)).SetRightSibling(page->index());
+            }
+            last_leaf_ = page->index();
+        }
+
+        level.previous_index       = page->index();
+        level.previous_lower_fence = level.lower_fence;
+        level.data.clear();
+        level.cells.clear();
+        level.used_size = 0;
+        level.right_child.reset();
+        return page->index();
+    }
+
+    void BulkLoader::WriteNode(pager::Page& page,
+                               const Level& level,
+                               NodeHeader::NodeType type,
+                               std::optional<common::ConstByteSpan> upper_fence)
+    {
+        common::ConstByteSpan prefix;
+        if(level.lower_fence && upper_fence)
+        {
+            prefix = common::ConstByteSpan(*level.lower_fence)
+                       .first(CommonPrefixSize(*level.lower_fence, *upper_fence));
+        }
+
+        Node node(page);
+        node.InitializeNewNode(type, prefix);
+        for(std::size_t i = 0; i < level.cells.size(); ++i)
+        {
+            auto key   = level.KeyAt(i);
+            auto value = common::ConstByteSpan(level.data)
+                           .subspan(level.cells[i].offset + key.size(), level.cells[i].value_size);
+            node.Insert(node.size(), key, value);
+        }
+        if(type == NodeHeader::NodeType::Inner)
+        {
+            node.SetChildAt(node.size(), *level.right_child);
+        }
+    }
+
+    bool BulkLoader::BalanceLastNodes(Level& level, NodeHeader::NodeType type)
+    {
+        if(!level.previous_index)
+        {
+            return false;
+        }
+
+        // Gather the cells of both nodes. Between the cells of two inner nodes, the rightmost
+        // child of the previous node gets the separator of the last node as its key.
+        auto page = pager_.GetPage(*level.previous_index);
+        Node previous(*page);
+        auto left_sibling = previous.is_leaf() ? previous.left_sibling() : 0;
+
+        Level combined;
+        combined.lower_fence = std::move(level.previous_lower_fence);
+        std::vector<std::byte> key;
+        for(NodeHeader::NodeSize pos = 0; pos < previous.size(); ++pos)
+        {
+            previous.CopyKeyAt(pos, key);
+            combined.Append(key, previous.ValueAt(pos));
+        }
+        if(type == NodeHeader::NodeType::Inner)
+        {
+            std::array<std::byte, sizeof(pager::Page::PageIndex)> previous_child;
+            common::Serialize(previous.right_child(), previous_child);
+            combined.Append(*level.lower_fence, previous_child);
+        }
+        for(std::size_t i = 0; i < level.cells.size(); ++i)
+        {
+            auto value = common::ConstByteSpan(level.data)
+                           .subspan(level.cells[i].offset + level.cells[i].key_size,
+                                    level.cells[i].value_size);
+            combined.Append(level.KeyAt(i), value);
+        }
+        combined.right_child = level.right_child;
+
+        if(combined.used_size <= fill_size_)
+        {
+            WriteNode(*page, combined, type, std::nullopt);
+            if(left_sibling != 0)
+            {
+                Node(*page).SetLeftSibling(left_sibling);
+            }
+            level.previous_index.reset();
+            return true;
+        }
+
+        // Split the cells in two halves of about the same size. The previous node keeps the first
+        // half and the last node gets the second half.
+        std::size_t middle = 0;
+        common::FileOffset left_size = 0;
+        while(2 * left_size < combined.used_size)
+        {
+            left_size += Cell::CalculateRequiredSize(combined.cells[middle].key_size,
+                                                     combined.cells[middle].value_size)
+                         + SlotArray::SLOT_SIZE;
+            ++middle;
+        }
+        middle = std::clamp<std::size_t>(middle, 1, combined.cells.size() - 1);
+
+        Level left;
+        left.lower_fence = std::move(combined.lower_fence);
+        Level right;
+        std::vector<std::byte> separator;
+        std::size_t first_right = middle;
+        if(type == NodeHeader::NodeType::Leaf)
+        {
+            // The separator is truncated like the separators of the splits.
+            auto next_key = combined.KeyAt(middle);
+            separator.assign(
+              next_key.begin(),
+              next_key.begin() + ShortestSeparatorSize(combined.KeyAt(middle - 1), next_key));
+        }
+        else
+        {
+            // The key of the middle cell is pushed up as the separator and its child becomes the
+            // rightmost child of the previous node.
+            auto middle_key = combined.KeyAt(middle);
+            separator.assign(middle_key.begin(), middle_key.end());
+            left.right_child = common::Deserialize<pager::Page::PageIndex>(
+              common::ConstByteSpan(combined.data)
+                .subspan(combined.cells[middle].offset + middle_key.size(),
+                         combined.cells[middle].value_size));
+            ++first_right;
+        }
+
+        for(std::size_t i = 0; i < combined.cells.size(); ++i)
+        {
+            auto value = common::ConstByteSpan(combined.data)
+                           .subspan(combined.cells[i].offset + combined.cells[i].key_size,
+                                    combined.cells[i].value_size);
+            if(i < middle)
+            {
+                left.Append(combined.KeyAt(i), value);
+            }
+            else if(i >= first_right)
+            {
+                right.Append(combined.KeyAt(i), value);
+            }
+        }
+        if(type == NodeHeader::NodeType::Inner)
+        {
+            right.right_child = combined.right_child;
+        }
+
+        WriteNode(*page, left, type, separator);
+        if(left_sibling != 0)
+        {
+            Node(*page).SetLeftSibling(left_sibling);
+        }
+
+        right.lower_fence    = std::move(separator);
+        right.previous_index = level.previous_index;
+        level                = std::move(right);
+        return false;
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
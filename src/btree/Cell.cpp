@@ -2,12 +2,18 @@
 
 namespace mkvdb::btree
 {
-    Cell::Cell(common::ByteSpan buffer, common::ConstByteSpan key, common::ConstByteSpan value)
-    : buffer_(buffer)
+    Cell::Cell(common::ByteSpan buffer,
+               common::ConstByteSpan key,
+               common::ConstByteSpan value,
+               bool has_overflow,
+               std::endian byte_order)
+    : buffer_(buffer),
+      byte_order_(byte_order)
     {
         assert(buffer_.size() == CalculateRequiredSize(key.size(), value.size()));
+        assert(key.size() < OVERFLOW_FLAG);
 
-        key_size(key.size());
+        key_size(has_overflow ? key.size() | OVERFLOW_FLAG : key.size());
         value_size(value.size());
         std::copy(key.begin(), key.end(), buffer_.begin() + KEY_OFFSET);
         std::copy(value.begin(), value.end(), buffer_.begin() + KEY_OFFSET + key.size());
@@ -0,0 +1,199 @@
+#include "mkvdb/btree/Cursor.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/Key.hpp"
+#include "mkvdb/btree/Node.hpp"
+#include "mkvdb/btree/OverflowReference.hpp"
+#include "mkvdb/btree/ValueReader.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+
+namespace mkvdb::btree
+{
+    Cursor::Cursor(const BTree& tree)
+    : tree_(tree),
+      position_(0)
+    {
+    }
+
+    bool Cursor::Seek(common::ConstByteSpan key)
+    {
+        leaf_     = tree_.FindLeaf(key, nullptr);
+        position_ = Node(*leaf_).Find(key).position;
+        return SettleForward();
+    }
+
+    bool Cursor::SeekToFirst()
+    {
+        // The empty key is smaller than all the other keys.
+        return Seek({});
+    }
+
+    bool Cursor::SeekToLast()
+    {
+        auto page = tree_.pager_.GetPage(tree_.root_index_);
+        while(!Node(*page).is_leaf())
+        {
+            page = tree_.pager_.GetPage(Node(*page).right_child());
+        }
+
+        leaf_     = std::move(page);
+        position_ = Node(*leaf_).size();
+        return MoveBackward();
+    }
+
+    bool Cursor::Next()
+    {
+        assert(is_valid());
+
+        ++position_;
+        return SettleForward();
+    }
+
+    bool Cursor::Prev()
+    {
+        assert(is_valid());
+
+        return MoveBackward();
+    }
+
+    common::ConstByteSpan Cursor::key() const
+    {
+        assert(is_valid());
+
+        return key_;
+    }
+
+    common::ConstByteSpan Cursor::value() const
+    {
+        assert(is_valid());
+
+        Node leaf(*leaf_);
+        auto value = leaf.ValueAt(position_);
+        if(!leaf.HasOverflowAt(position_))
+        {
+            return value;
+        }
+
+        ValueReader reader(tree_.pager_, value, true);
+        overflow_value_.resize(reader.size());
+        reader.Read(overflow_value_);
+        return overflow_value_;
+    }
+
+    std::size_t Cursor::ScanBatch(KeyValueBatch& batch,
+                                  std::size_t max_rows,
+                                  common::FileOffset max_bytes,
+                                  std::optional<common::ConstByteSpan> end)
+    {
+        batch.Clear();
+
+        while(is_valid() && batch.size() < max_rows)
+        {
+            Node leaf(*leaf_);
+            auto next = leaf.right_sibling();
+            if(next != 0)
+            {
+                tree_.pager_.Prefetch(std::span(&next, 1));
+            }
+
+            auto prefix = leaf.prefix();
+            for(; position_ < leaf.size() && batch.size() < max_rows; ++position_)
+            {
+                auto suffix       = leaf.SuffixAt(position_);
+                auto value        = leaf.ValueAt(position_);
+                auto has_overflow = leaf.HasOverflowAt(position_);
+                auto value_size =
+                  has_overflow ? OverflowReference(value).value_size() : value.size();
+                auto key_size = prefix.size() + suffix.size();
+                if(!batch.empty() && batch.byte_size() + key_size + value_size > max_bytes)
+                {
+                    LoadKey();
+                    return batch.size();
+                }
+
+                auto [key_buffer, value_buffer] = batch.Emplace(key_size, value_size);
+                std::copy(suffix.begin(),
+                          suffix.end(),
+                          std::copy(prefix.begin(), prefix.end(), key_buffer.begin()));
+                if(end && CompareKeys(key_buffer, *end) >= 0)
+                {
+                    batch.PopBack();
+                    leaf_.reset();
+                    return batch.size();
+                }
+
+                if(has_overflow)
+                {
+                    ValueReader(tree_.pager_, value, true).Read(value_buffer);
+                }
+                else
+                {
+                    std::copy(value.begin(), value.end(), value_buffer.begin());
+                }
+            }
+
+            if(position_ < leaf.size())
+            {
+                break;
+            }
+            if(next == 0)
+            {
+                leaf_.reset();
+                break;
+            }
+            leaf_     = tree_.pager_.GetPage(next);
+            position_ = 0;
+        }
+
+        if(is_valid())
+        {
+            SettleForward();
+        }
+        return batch.size();
+    }
+
+    bool Cursor::SettleForward()
+    {
+        while(position_ >= Node(*leaf_).size())
+        {
+            auto next = Node(*leaf_).right_sibling();
+            if(next == 0)
+            {
+                leaf_.reset();
+                return false;
+            }
+            leaf_     = tree_.pager_.GetPage(next);
+            position_ = 0;
+        }
+
+        LoadKey();
+        return true;
+    }
+
+    bool Cursor::MoveBackward()
+    {
+        while(position_ == 0)
+        {
+            auto previous = Node(*leaf_).left_sibling();
+            if(previous == 0)
+            {
+                leaf_.reset();
+                return false;
+            }
+            leaf_     = tree_.pager_.GetPage(previous);
+            position_ = Node(*leaf_).size();
+        }
+
+        --position_;
+        LoadKey();
+        return true;
+    }
+
+    void Cursor::LoadKey()
+    {
+        Node(*leaf_).CopyKeyAt(position_, key_);
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
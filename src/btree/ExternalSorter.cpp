@@ -0,0 +1,361 @@
+#include "mkvdb/btree/ExternalSorter.hpp"
+
+#include "mkvdb/btree/Key.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Serialization.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace mkvdb::btree
+{
+    namespace
+    {
+        /// Returns the key of the record at a given offset of a run.
+        common::ConstByteSpan RecordKey(common::ConstByteSpan records, std::size_t offset)
+        {
+            auto key_size = common::Deserialize<common::ValueSize>(records.subspan(offset));
+            return records.subspan(offset + 2 * sizeof(common::ValueSize), key_size);
+        }
+
+        /// Returns the size of the record at a given offset of a run.
+        std::size_t RecordSize(common::ConstByteSpan records, std::size_t offset)
+        {
+            auto key_size   = common::Deserialize<common::ValueSize>(records.subspan(offset));
+            auto value_size = common::Deserialize<common::ValueSize>(
+              records.subspan(offset + sizeof(common::ValueSize)));
+            return 2 * sizeof(common::ValueSize) + key_size + value_size;
+        }
+    } // namespace
+
+    ExternalSorter::ExternalSorter(FileFactory create_file,
+                                   std::size_t run_size,
+                                   std::size_t threads_count)
+    : create_file_(std::move(create_file)),
+      run_size_(run_size),
+      threads_count_(threads_count),
+      threads_(threads_count),
+      is_finished_(false),
+      is_started_(false),
+      winner_(0)
+    {
+    }
+
+    ExternalSorter::~ExternalSorter()
+    {
+        // The files can only be deleted once no thread writes them anymore.
+        for(auto& spill : spills_)
+        {
+            spill.wait();
+        }
+        readers_.clear();
+        for(auto& file : files_)
+        {
+            file->Close();
+            file->Delete();
+        }
+    }
+
+    void ExternalSorter::Add(common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        assert(!is_finished_);
+
+        // The sizes are stored on 32 bits in the records of the runs.
+        if(key.size() > std::numeric_limits<common::ValueSize>::max())
+        {
+            throw common::MkvDBException("The key is too large.");
+        }
+        if(value.size() > std::numeric_limits<common::ValueSize>::max())
+        {
+            throw common::MkvDBException("The value is too large.");
+        }
+
+        auto size = RECORD_HEADER_SIZE + key.size() + value.size();
+        if(!run_.offsets.empty() && run_.records.size() + size > run_size_)
+        {
+            SpillRun();
+        }
+
+        auto offset = run_.records.size();
+        run_.offsets.push_back(offset);
+        run_.records.resize(offset + RECORD_HEADER_SIZE);
+        auto header = common::ByteSpan(run_.records).subspan(offset);
+        common::Serialize(static_cast<common::ValueSize>(key.size()), header);
+        common::Serialize(static_cast<common::ValueSize>(value.size()),
+                          header.subspan(sizeof(common::ValueSize)));
+        run_.records.insert(run_.records.end(), key.begin(), key.end());
+        run_.records.insert(run_.records.end(), value.begin(), value.end());
+    }
+
+    void ExternalSorter::Finish()
+    {
+        assert(!is_finished_);
+        is_finished_ = true;
+
+        // The last run is merged from memory while the other runs are spilled.
+        SortRun(run_);
+        std::vector<std::byte> records;
+        records.reserve(run_.records.size());
+        for(auto offset : run_.offsets)
+        {
+            auto record = common::ConstByteSpan(run_.records)
+                            .subspan(offset, RecordSize(run_.records, offset));
+            records.insert(records.end(), record.begin(), record.end());
+        }
+        run_ = {};
+
+        while(!spills_.empty())
+        {
+            WaitForSpill();
+        }
+
+        // The blocks read from the files share the memory of a run.
+        auto block_size = std::max(MIN_READ_BLOCK_SIZE, run_size_ / (files_.size() + 1));
+        readers_.reserve(files_.size() + 1);
+        for(auto& file : files_)
+        {
+            readers_.emplace_back(*file, block_size);
+        }
+        readers_.emplace_back(std::move(records));
+    }
+
+    bool ExternalSorter::Next()
+    {
+        assert(is_finished_);
+
+        if(!is_started_)
+        {
+            is_started_ = true;
+            for(auto& reader : readers_)
+            {
+                reader.Next();
+            }
+            losers_.assign(readers_.size(), 0);
+            winner_ = BuildLoserTree(1);
+            return !readers_[winner_].is_exhausted();
+        }
+
+        // Only the matches on the path of the previous winner must be replayed.
+        auto winner = winner_;
+        readers_[winner].Next();
+        for(auto node = (winner + readers_.size()) / 2; node > 0; node /= 2)
+        {
+            if(IsBefore(losers_[node], winner))
+            {
+                std::swap(losers_[node], winner);
+            }
+        }
+        winner_ = winner;
+
+        return !readers_[winner_].is_exhausted();
+    }
+
+    common::ConstByteSpan ExternalSorter::key() const
+    {
+        return readers_[winner_].key();
+    }
+
+    common::ConstByteSpan ExternalSorter::value() const
+    {
+        return readers_[winner_].value();
+    }
+
+    void ExternalSorter::SortRun(Run& run)
+    {
+        common::ConstByteSpan records(run.records);
+        std::stable_sort(run.offsets.begin(),
+                         run.offsets.end(),
+                         [records](std::size_t lhs, std::size_t rhs) {
+                             return CompareKeys(RecordKey(records, lhs), RecordKey(records, rhs))
+                                    < 0;
+                         });
+    }
+
+    void ExternalSorter::WriteRun(const Run& run, fs::IFile& file)
+    {
+        std::vector<std::byte> block;
+        block.reserve(WRITE_BLOCK_SIZE);
+        common::FileOffset file_offset = 0;
+
+        auto flush = [&]()
+        {
+            file.Write(block, file_offset);
+            file_offset += block.size();
+            block.clear();
+        };
+
+        for(auto offset : run.offsets)
+        {
+            auto record = common::ConstByteSpan(run.records)
+                            .subspan(offset, RecordSize(run.records, offset));
+            if(block.size() + record.size() > WRITE_BLOCK_SIZE && !block.empty())
+            {
+                flush();
+            }
+            block.insert(block.end(), record.begin(), record.end());
+        }
+        if(!block.empty())
+        {
+            flush();
+        }
+    }
+
+    void ExternalSorter::SpillRun()
+    {
+        // Bound the number of runs in memory.
+        while(spills_.size() >= threads_count_)
+        {
+            WaitForSpill();
+        }
+
+        // The file is created by the calling thread because the factory may not be thread-safe.
+        files_.push_back(create_file_());
+        auto& file = *files_.back();
+        file.Create();
+
+        auto run = std::make_shared<Run>(std::move(run_));
+        run_     = {};
+        run_.records.reserve(run->records.size());
+
+        spills_.push_back(threads_.Submit(
+          [run, &file]()
+          {
+              SortRun(*run);
+              WriteRun(*run, file);
+          }));
+    }
+
+    void ExternalSorter::WaitForSpill()
+    {
+        auto spill = std::move(spills_.front());
+        spills_.pop_front();
+        spill.get();
+    }
+
+    bool ExternalSorter::IsBefore(std::size_t lhs, std::size_t rhs) const
+    {
+        const auto& lhs_reader = readers_[lhs];
+        const auto& rhs_reader = readers_[rhs];
+        if(lhs_reader.is_exhausted() || rhs_reader.is_exhausted())
+        {
+            return !lhs_reader.is_exhausted();
+        }
+
+        // The runs are in the order the pairs were added, so equal keys are taken from the first
+        // run first.
+        auto comparison = CompareKeys(lhs_reader.key(), rhs_reader.key());
+        return comparison < 0 || (comparison == 0 && lhs < rhs);
+    }
+
+    std::size_t ExternalSorter::BuildLoserTree(std::size_t node)
+    {
+        if(node >= readers_.size())
+        {
+            return node - readers_.size();
+        }
+
+        auto left  = BuildLoserTree(2 * node);
+        auto right = BuildLoserTree(2 * node + 1);
+        if(IsBefore(left, right))
+        {
+            losers_[node] = right;
+            return left;
+        }
+        losers_[node] = left;
+        return right;
+    }
+
+    ExternalSorter::RunReader::RunReader(fs::IFile& file, std::size_t block_size)
+    : file_(&file),
+      file_offset_(0),
+      buffer_(block_size),
+      begin_(0),
+      end_(0),
+      record_size_(0),
+      is_exhausted_(false)
+    {
+        file_->WillNeed(0, block_size);
+    }
+
+    ExternalSorter::RunReader::RunReader(std::vector<std::byte> records)
+    : file_(nullptr),
+      file_offset_(0),
+      buffer_(std::move(records)),
+      begin_(0),
+      end_(buffer_.size()),
+      record_size_(0),
+      is_exhausted_(false)
+    {
+    }
+
+    bool ExternalSorter::RunReader::Next()
+    {
+        begin_ += record_size_;
+        record_size_ = 0;
+
+        if(!Fill(RECORD_HEADER_SIZE))
+        {
+            if(begin_ != end_)
+            {
+                throw common::MkvDBException("A run of the external sort is truncated.");
+            }
+            is_exhausted_ = true;
+            key_          = {};
+            value_        = {};
+            return false;
+        }
+
+        auto header     = common::ConstByteSpan(buffer_).subspan(begin_, RECORD_HEADER_SIZE);
+        auto key_size   = common::Deserialize<common::ValueSize>(header);
+        auto value_size = common::Deserialize<common::ValueSize>(
+          header.subspan(sizeof(common::ValueSize)));
+        if(!Fill(RECORD_HEADER_SIZE + key_size + value_size))
+        {
+            throw common::MkvDBException("A run of the external sort is truncated.");
+        }
+        record_size_ = RECORD_HEADER_SIZE + key_size + value_size;
+
+        key_   = common::ConstByteSpan(buffer_).subspan(begin_ + RECORD_HEADER_SIZE, key_size);
+        value_ = common::ConstByteSpan(buffer_).subspan(begin_ + RECORD_HEADER_SIZE + key_size,
+                                                       value_size);
+        return true;
+    }
+
+    bool ExternalSorter::RunReader::Fill(std::size_t size)
+    {
+        if(end_ - begin_ >= size)
+        {
+            return true;
+        }
+        if(!file_)
+        {
+            return false;
+        }
+
+        // Move the bytes not read yet to the start of the buffer and read the next block after
+        // them.
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+        if(buffer_.size() < size)
+        {
+            buffer_.resize(size);
+        }
+
+        auto read_size =
+          std::min<common::FileOffset>(buffer_.size() - end_, file_->size() - file_offset_);
+        if(read_size > 0)
+        {
+            file_->Read(common::ByteSpan(buffer_).subspan(end_, read_size), file_offset_);
+            file_offset_ += read_size;
+            end_ += read_size;
+            file_->WillNeed(file_offset_, buffer_.size());
+        }
+
+        return end_ >= size;
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
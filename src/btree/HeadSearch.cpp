@@ -0,0 +1,79 @@
+#include "mkvdb/btree/HeadSearch.hpp"
+
+#include "mkvdb/common/Serialization.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
+namespace mkvdb::btree
+{
+    std::uint32_t MakeHead(common::ConstByteSpan key)
+    {
+        std::array<std::byte, HEAD_SIZE> buffer = {};
+        auto size                               = std::min(key.size(), HEAD_SIZE);
+        std::copy(key.begin(), key.begin() + size, buffer.begin());
+        return common::Deserialize<std::uint32_t>(buffer);
+    }
+
+    std::size_t CountHeadsLessThan(const std::byte* heads, std::size_t count, std::uint32_t head)
+    {
+        std::size_t result = 0;
+        std::size_t i      = 0;
+
+        // The SIMD compares are signed, so the heads and the value are biased by INT32_MIN to
+        // compare them as unsigned values. The heads are stored in big-endian order and their bytes
+        // are swapped to the little-endian order of the x86 processors.
+#if defined(__AVX2__)
+        const __m256i bias_256    = _mm256_set1_epi32(INT32_MIN);
+        const __m256i target_256  = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(head)),
+                                                    bias_256);
+        const __m256i reverse_256 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+                                                     13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8,
+                                                     15, 14, 13, 12);
+        for(; i + 8 <= count; i += 8)
+        {
+            __m256i values = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(heads + i * HEAD_SIZE));
+            values         = _mm256_shuffle_epi8(values, reverse_256);
+            values         = _mm256_xor_si256(values, bias_256);
+            __m256i less   = _mm256_cmpgt_epi32(target_256, values);
+            result += std::popcount(
+              static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(less))));
+        }
+#endif
+
+#if defined(__SSE2__)
+        const __m128i bias   = _mm_set1_epi32(INT32_MIN);
+        const __m128i target = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(head)), bias);
+        const __m128i mask_1 = _mm_set1_epi32(0x00ff0000);
+        const __m128i mask_2 = _mm_set1_epi32(0x0000ff00);
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i values =
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(heads + i * HEAD_SIZE));
+            values = _mm_or_si128(
+              _mm_or_si128(_mm_slli_epi32(values, 24), _mm_srli_epi32(values, 24)),
+              _mm_or_si128(_mm_and_si128(_mm_slli_epi32(values, 8), mask_1),
+                           _mm_and_si128(_mm_srli_epi32(values, 8), mask_2)));
+            values       = _mm_xor_si128(values, bias);
+            __m128i less = _mm_cmplt_epi32(values, target);
+            result += std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(less))));
+        }
+#endif
+
+        for(; i < count; ++i)
+        {
+            auto value = common::Deserialize<std::uint32_t>(
+              common::ConstByteSpan(heads + i * HEAD_SIZE, HEAD_SIZE));
+            result += value < head ? 1 : 0;
+        }
+
+        return result;
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "mkvdb/btree/InterleavedLookup.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/HeadSearch.hpp"
+#include "mkvdb/btree/Node.hpp"
+#include "mkvdb/btree/ValueReader.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace mkvdb::btree
+{
+    namespace
+    {
+        /// Size of a CPU cache line in bytes.
+        constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        /// Maximum number of cache lines of heads prefetched in a node. The search reads a few
+        /// heads scattered over the array and then scans a short range, so prefetching a large
+        /// array entirely would only evict useful lines.
+        constexpr std::size_t MAX_PREFETCHED_HEAD_LINES = 8;
+
+        /// Ask the CPU to start loading a range of memory in its caches.
+        void PrefetchMemory(const std::byte* data, std::size_t size)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            for(std::size_t offset = 0; offset < size; offset += CACHE_LINE_SIZE)
+            {
+                __builtin_prefetch(data + offset);
+            }
+#else
+            (void)data;
+            (void)size;
+#endif
+        }
+
+        /// Awaitable suspending a lookup so the engine resumes the next one.
+        struct Yield
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<>) const noexcept {}
+            void await_resume() const noexcept {}
+        };
+    } // namespace
+
+    class InterleavedLookup::Task
+    {
+    public:
+        struct promise_type
+        {
+            std::exception_ptr exception;
+
+            Task get_return_object()
+            {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            // A lookup starts suspended and only runs when the engine resumes it.
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { exception = std::current_exception(); }
+        };
+
+        explicit Task(std::coroutine_handle<promise_type> handle)
+        : handle_(handle)
+        {
+        }
+
+        Task(Task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+        {
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            std::swap(handle_, other.handle_);
+            return *this;
+        }
+
+        Task(const Task&)            = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task()
+        {
+            if(handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        /// Run the lookup until its next suspension.
+        /// @return False if the lookup is complete.
+        bool Resume()
+        {
+            handle_.resume();
+            if(!handle_.done())
+            {
+                return true;
+            }
+            if(handle_.promise().exception)
+            {
+                std::rethrow_exception(handle_.promise().exception);
+            }
+            return false;
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    InterleavedLookup::InterleavedLookup(const BTree& tree, std::size_t group_size)
+    : tree_(tree),
+      group_size_(group_size)
+    {
+        assert(group_size_ > 0);
+    }
+
+    std::vector<std::optional<std::vector<std::byte>>>
+      InterleavedLookup::Get(std::span<const common::ConstByteSpan> keys) const
+    {
+        std::vector<std::optional<std::vector<std::byte>>> values(keys.size());
+
+        // The lookups of the group are resumed in turn. A completed lookup is replaced by the
+        // lookup of the next key, so the group stays full until the keys run out.
+        std::vector<Task> group;
+        std::size_t next = 0;
+        for(; next < keys.size() && group.size() < group_size_; ++next)
+        {
+            group.push_back(Lookup(keys[next], values[next]));
+        }
+
+        std::size_t x = 0;
+        while(!group.empty())
+        {
+            if(group[x].Resume())
+            {
+                ++x;
+            }
+            else if(next < keys.size())
+            {
+                group[x] = Lookup(keys[next], values[next]);
+                ++next;
+                ++x;
+            }
+            else
+            {
+                group[x] = std::move(group.back());
+                group.pop_back();
+            }
+
+            if(x >= group.size())
+            {
+                x = 0;
+            }
+        }
+
+        return values;
+    }
+
+    InterleavedLookup::Task InterleavedLookup::Lookup(
+      common::ConstByteSpan key, std::optional<std::vector<std::byte>>& value) const
+    {
+        auto& pager = tree_.pager_;
+        auto index  = tree_.root_index_;
+        while(true)
+        {
+            // The page is read by the I/O threads of the pager if it is not loaded yet.
+            pager.Prefetch(std::span(&index, 1));
+            co_await Yield{};
+
+            auto page    = pager.GetPage(index);
+            auto content = page->content();
+            PrefetchMemory(content.data(), NodeHeader::HEADER_SIZE);
+            co_await Yield{};
+
+            // The header gives the location of the heads, which are read first by the search.
+            Node node(*page);
+            auto heads = content.subspan(NodeHeader::HEADER_SIZE + node.prefix().size());
+            PrefetchMemory(heads.data(),
+                           std::min(node.size() * HEAD_SIZE,
+                                    MAX_PREFETCHED_HEAD_LINES * CACHE_LINE_SIZE));
+            co_await Yield{};
+
+            if(!node.is_leaf())
+            {
+                index = node.ChildAt(node.FindChildPosition(key));
+                continue;
+            }
+
+            auto result = node.Find(key);
+            if(result.found)
+            {
+                auto cell_value = node.ValueAt(result.position);
+                if(node.HasOverflowAt(result.position))
+                {
+                    ValueReader reader(pager, cell_value, true);
+                    auto& whole_value = value.emplace(reader.size());
+                    reader.Read(whole_value);
+                }
+                else
+                {
+                    value.emplace(cell_value.begin(), cell_value.end());
+                }
+            }
+            co_return;
+        }
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
@@ -1,6 +1,208 @@
 #include "mkvdb/btree/Node.hpp"
 
+#include "mkvdb/btree/Key.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
 namespace mkvdb::btree
 {
-    void Node::Insert(common::ConstByteSpan key, common::ConstByteSpan value) {}
+    void Node::InitializeNewNode(NodeHeader::NodeType type, common::ConstByteSpan prefix)
+    {
+        auto content = page_.content();
+        assert(NodeHeader::HEADER_SIZE + prefix.size() <= content.size());
+
+        header_.size(0);
+        header_.byte_size(0);
+        header_.unallocated_space(static_cast<NodeHeader::NodeSize>(
+          content.size() - NodeHeader::HEADER_SIZE - prefix.size()));
+        header_.type(type);
+        header_.right_child(0);
+        header_.prefix_size(static_cast<NodeHeader::NodeSize>(prefix.size()));
+        header_.left_sibling(0);
+        header_.right_sibling(0);
+        std::copy(prefix.begin(), prefix.end(), content.begin() + NodeHeader::HEADER_SIZE);
+        page_.MarkAsModified();
+    }
+
+    Node::SearchResult Node::Find(common::ConstByteSpan key) const
+    {
+        // The prefix is compared once. A key that does not start with the prefix is either
+        // smaller or greater than all the keys of the node.
+        auto node_prefix = prefix();
+        auto common_size = std::min(node_prefix.size(), key.size());
+        int comparison   = CompareKeys(key.first(common_size), node_prefix.first(common_size));
+        if(comparison < 0 || (comparison == 0 && key.size() < node_prefix.size()))
+        {
+            return { 0, false };
+        }
+        if(comparison > 0)
+        {
+            return { header_.size(), false };
+        }
+        auto suffix = key.subspan(node_prefix.size());
+
+        // Only the suffixes with the same head as the searched suffix need to be compared.
+        auto header = header_;
+        SlotArray slots(header, page_.content());
+        auto head                 = MakeHead(suffix);
+        NodeHeader::NodeSize low  = slots.LowerBound(head);
+        NodeHeader::NodeSize high = slots.UpperBound(head);
+
+        while(low < high)
+        {
+            NodeHeader::NodeSize middle = low + (high - low) / 2;
+            comparison                  = CompareKeys(SuffixAt(middle), suffix);
+            if(comparison < 0)
+            {
+                low = middle + 1;
+            }
+            else if(comparison > 0)
+            {
+                high = middle;
+            }
+            else
+            {
+                return { middle, true };
+            }
+        }
+
+        return { low, false };
+    }
+
+    void Node::Insert(NodeHeader::NodeSize pos,
+                      common::ConstByteSpan key,
+                      common::ConstByteSpan value,
+                      bool has_overflow)
+    {
+        assert(pos <= header_.size());
+        assert(CanInsert(key.size(), value.size()));
+
+        assert(std::equal(prefix().begin(), prefix().end(), key.begin()));
+        auto suffix = key.subspan(header_.prefix_size());
+
+        auto content   = page_.content();
+        auto cell_size = Cell::CalculateRequiredSize(suffix.size(), value.size());
+        if(header_.unallocated_space() < cell_size + SlotArray::SLOT_SIZE)
+        {
+            Compact();
+        }
+        auto offset = cells_offset() - cell_size;
+
+        Cell(content.subspan(offset, cell_size), suffix, value, has_overflow, header_.byte_order());
+        header_.unallocated_space(header_.unallocated_space() - cell_size);
+        header_.byte_size(header_.byte_size() + cell_size);
+        SlotArray(header_, content)
+          .Insert(pos, static_cast<common::PageOffset>(offset), MakeHead(suffix));
+
+        page_.MarkAsModified();
+    }
+
+    void Node::Insert(common::ConstByteSpan key, common::ConstByteSpan value)
+    {
+        auto result = Find(key);
+        assert(!result.found);
+
+        Insert(result.position, key, value);
+    }
+
+    void Node::ReplaceValue(NodeHeader::NodeSize pos, common::ConstByteSpan value)
+    {
+        auto content = page_.content();
+        auto current = ValueAt(pos);
+        assert(current.size() == value.size());
+
+        auto destination = content.subspan(current.data() - content.data(), current.size());
+        std::copy(value.begin(), value.end(), destination.begin());
+
+        page_.MarkAsModified();
+    }
+
+    void Node::Erase(NodeHeader::NodeSize pos)
+    {
+        assert(pos < header_.size());
+
+        auto content   = page_.content();
+        SlotArray slots(header_, content);
+        auto offset    = slots.At(pos);
+        auto cell_size = Cell::ReadSize(content.subspan(offset), header_.byte_order());
+
+        // When the erased cell is the first of the cells area, its space is given back to the
+        // unallocated space. Otherwise it leaves a hole that is only counted in the free space.
+        if(offset == cells_offset())
+        {
+            header_.unallocated_space(header_.unallocated_space() + cell_size);
+        }
+        header_.byte_size(header_.byte_size() - cell_size);
+        slots.Erase(pos);
+
+        page_.MarkAsModified();
+    }
+
+    void Node::Compact()
+    {
+        // The scratch buffer only grows, to the size of the largest page seen by the thread.
+        thread_local std::vector<std::byte> scratch;
+        auto content = page_.content();
+        if(scratch.size() < content.size())
+        {
+            scratch.resize(content.size());
+        }
+        std::copy(content.begin(), content.end(), scratch.begin());
+
+        // The cells are copied back from the end of the node in the order of the slots.
+        SlotArray slots(header_, content);
+        auto end = content.size();
+        for(NodeHeader::NodeSize i = 0; i < header_.size(); ++i)
+        {
+            auto cell      = common::ConstByteSpan(scratch).subspan(slots.At(i));
+            auto cell_size = Cell::ReadSize(cell, header_.byte_order());
+            end -= cell_size;
+            std::copy_n(cell.begin(), cell_size, content.begin() + end);
+            slots.Set(i, static_cast<common::PageOffset>(end));
+        }
+
+        header_.unallocated_space(static_cast<NodeHeader::NodeSize>(
+          end - NodeHeader::HEADER_SIZE - header_.prefix_size()
+          - header_.size() * SlotArray::SLOT_SIZE));
+        assert(header_.unallocated_space() == free_space());
+
+        page_.MarkAsModified();
+    }
+
+    void Node::SetChildAt(NodeHeader::NodeSize pos, pager::Page::PageIndex index)
+    {
+        assert(!is_leaf());
+        assert(pos <= size());
+
+        if(pos == size())
+        {
+            header_.right_child(index);
+            page_.MarkAsModified();
+        }
+        else
+        {
+            std::array<std::byte, sizeof(pager::Page::PageIndex)> value;
+            common::Serialize(index, value);
+            ReplaceValue(pos, value);
+        }
+    }
+
+    void Node::SetLeftSibling(pager::Page::PageIndex index)
+    {
+        assert(is_leaf());
+
+        header_.left_sibling(index);
+        page_.MarkAsModified();
+    }
+
+    void Node::SetRightSibling(pager::Page::PageIndex index)
+    {
+        assert(is_leaf());
+
+        header_.right_sibling(index);
+        page_.MarkAsModified();
+    }
 } // namespace mkvdb::btree
\ No newline at end of file
@@ -1,39 +1,108 @@
 #include "mkvdb/btree/SlotArray.hpp"
 
+#include <cstring>
+
 namespace mkvdb::btree
 {
-    void SlotArray::Insert(std::uint16_t pos, std::uint16_t offset)
+    void SlotArray::Insert(std::uint16_t pos, std::uint16_t offset, std::uint32_t head)
     {
         assert(pos <= header_.size());
-        assert(header_.unallocated_space() >= PAGE_OFFSET_SIZE);
+        assert(header_.unallocated_space() >= SLOT_SIZE);
 
-        std::copy_backward(buffer_.begin() + pos * PAGE_OFFSET_SIZE,
-                           buffer_.begin() + header_.size() * PAGE_OFFSET_SIZE,
-                           buffer_.begin() + (header_.size() + 1) * PAGE_OFFSET_SIZE);
+        // The offsets array moves HEAD_SIZE bytes forward to make room for the new head and the
+        // offsets after pos move one more slot to make room for the new offset. The offsets are
+        // moved first because the heads are moved over their old location.
+        auto size        = header_.size();
+        auto old_offsets = buffer_.data() + offsets_offset();
+        auto new_offsets = old_offsets + HEAD_SIZE;
+        std::memmove(new_offsets + (pos + 1) * PAGE_OFFSET_SIZE,
+                     old_offsets + pos * PAGE_OFFSET_SIZE,
+                     (size - pos) * PAGE_OFFSET_SIZE);
+        std::memmove(new_offsets, old_offsets, pos * PAGE_OFFSET_SIZE);
+        std::memmove(buffer_.data() + (pos + 1) * HEAD_SIZE,
+                     buffer_.data() + pos * HEAD_SIZE,
+                     (size - pos) * HEAD_SIZE);
 
-        common::Serialize(offset, buffer_.subspan(pos * PAGE_OFFSET_SIZE, PAGE_OFFSET_SIZE));
+        common::Serialize(head, buffer_.subspan(pos * HEAD_SIZE, HEAD_SIZE));
+        OffsetField::Write(new_offsets + pos * PAGE_OFFSET_SIZE, offset, header_.byte_order());
 
-        header_.size(header_.size() + 1);
-        header_.unallocated_space(header_.unallocated_space() - PAGE_OFFSET_SIZE);
+        header_.size(size + 1);
+        header_.unallocated_space(header_.unallocated_space() - SLOT_SIZE);
     }
 
     std::uint16_t SlotArray::At(std::uint16_t pos) const
     {
         assert(pos < header_.size());
 
-        return common::Deserialize<std::uint16_t>(
-          buffer_.subspan(pos * PAGE_OFFSET_SIZE, PAGE_OFFSET_SIZE));
+        return OffsetField::Read(buffer_.data() + offsets_offset() + pos * PAGE_OFFSET_SIZE,
+                                 header_.byte_order());
+    }
+
+    void SlotArray::Set(std::uint16_t pos, std::uint16_t offset)
+    {
+        assert(pos < header_.size());
+
+        OffsetField::Write(buffer_.data() + offsets_offset() + pos * PAGE_OFFSET_SIZE,
+                           offset,
+                           header_.byte_order());
+    }
+
+    std::uint32_t SlotArray::HeadAt(std::uint16_t pos) const
+    {
+        assert(pos < header_.size());
+
+        return common::Deserialize<std::uint32_t>(buffer_.subspan(pos * HEAD_SIZE, HEAD_SIZE));
     }
 
     void SlotArray::Erase(std::uint16_t pos)
     {
         assert(pos < header_.size());
 
-        std::copy(buffer_.begin() + (pos + 1) * PAGE_OFFSET_SIZE,
-                  buffer_.begin() + header_.size() * PAGE_OFFSET_SIZE,
-                  buffer_.begin() + pos * PAGE_OFFSET_SIZE);
+        // Reverse of Insert: the heads are moved first because the offsets are moved over the
+        // location of the last head.
+        auto size        = header_.size();
+        auto old_offsets = buffer_.data() + offsets_offset();
+        auto new_offsets = old_offsets - HEAD_SIZE;
+        std::memmove(buffer_.data() + pos * HEAD_SIZE,
+                     buffer_.data() + (pos + 1) * HEAD_SIZE,
+                     (size - pos - 1) * HEAD_SIZE);
+        std::memmove(new_offsets, old_offsets, pos * PAGE_OFFSET_SIZE);
+        std::memmove(new_offsets + pos * PAGE_OFFSET_SIZE,
+                     old_offsets + (pos + 1) * PAGE_OFFSET_SIZE,
+                     (size - pos - 1) * PAGE_OFFSET_SIZE);
+
+        header_.size(size - 1);
+        header_.unallocated_space(header_.unallocated_space() + SLOT_SIZE);
+    }
+
+    std::uint16_t SlotArray::LowerBound(std::uint32_t head) const
+    {
+        std::uint16_t low  = 0;
+        std::uint16_t high = header_.size();
 
-        header_.size(header_.size() - 1);
-        header_.unallocated_space(header_.unallocated_space() + PAGE_OFFSET_SIZE);
+        while(high - low > SCAN_THRESHOLD)
+        {
+            std::uint16_t middle = low + (high - low) / 2;
+            if(HeadAt(middle) < head)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        return static_cast<std::uint16_t>(
+          low + CountHeadsLessThan(buffer_.data() + low * HEAD_SIZE, high - low, head));
+    }
+
+    std::uint16_t SlotArray::UpperBound(std::uint32_t head) const
+    {
+        if(head == UINT32_MAX)
+        {
+            return header_.size();
+        }
+        return LowerBound(head + 1);
     }
-}
\ No newline at end of file
+} // namespace mkvdb::btree
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "mkvdb/btree/ValueReader.hpp"
+
+#include "mkvdb/btree/OverflowReference.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace mkvdb::btree
+{
+    ValueReader::ValueReader(pager::Pager& pager,
+                             common::ConstByteSpan cell_value,
+                             bool has_overflow)
+    : pager_(pager),
+      first_page_(0),
+      overflow_size_(0),
+      position_(0)
+    {
+        if(has_overflow)
+        {
+            OverflowReference reference(cell_value);
+            cell_value     = reference.inline_part();
+            first_page_    = reference.first_page();
+            overflow_size_ = reference.overflow_size();
+        }
+        inline_part_.assign(cell_value.begin(), cell_value.end());
+    }
+
+    void ValueReader::Seek(common::FileOffset position)
+    {
+        if(position > size())
+        {
+            throw common::MkvDBException("Cannot seek past the end of the value.");
+        }
+        position_ = position;
+    }
+
+    std::size_t ValueReader::Read(common::ByteSpan buffer)
+    {
+        auto count = static_cast<std::size_t>(std::min<common::FileOffset>(buffer.size(),
+                                                                           size() - position_));
+        auto out   = buffer.first(count);
+
+        if(position_ < inline_part_.size())
+        {
+            auto size = std::min<std::size_t>(out.size(), inline_part_.size() - position_);
+            std::copy_n(inline_part_.begin() + position_, size, out.begin());
+            out = out.subspan(size);
+            position_ += size;
+        }
+
+        if(!out.empty())
+        {
+            // The pages of the range are requested ahead of the copy so they are read while the
+            // previous ones are copied. They are read as a scan, so they go through the sequential
+            // ring instead of filling the pages cache. The pages in flight are bounded by the
+            // window of the ring, and the next half of the window is requested each time the copy
+            // has consumed half of it.
+            auto page_size  = pager_.page_size();
+            auto window     = pager_.sequential_window();
+            auto offset     = position_ - inline_part_.size();
+            auto first      = offset / page_size;
+            auto last       = (offset + out.size() - 1) / page_size;
+            auto prefetched = first + 1;
+            std::vector<pager::Page::PageIndex> indexes;
+
+            for(auto index = first; !out.empty(); ++index)
+            {
+                if(prefetched <= last && prefetched - index <= window / 2)
+                {
+                    auto end = std::min<common::FileOffset>(last + 1, index + 1 + window);
+                    indexes.resize(end - prefetched);
+                    std::iota(indexes.begin(), indexes.end(), first_page_ + prefetched);
+                    pager_.Prefetch(indexes, pager::AccessHint::Sequential);
+                    prefetched = end;
+                }
+
+                auto page        = pager_.GetPage(static_cast<pager::Page::PageIndex>(
+                                             first_page_ + index),
+                                           pager::AccessHint::Sequential);
+                auto page_offset = offset % page_size;
+                auto size        = std::min<std::size_t>(out.size(), page_size - page_offset);
+                std::copy_n(page->data().begin() + page_offset, size, out.begin());
+                out = out.subspan(size);
+                offset += size;
+            }
+            position_ = inline_part_.size() + offset;
+        }
+
+        return count;
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "mkvdb/btree/ValueWriter.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/OverflowReference.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace mkvdb::btree
+{
+    ValueWriter::ValueWriter(BTree& tree, common::ConstByteSpan key, common::FileOffset size)
+    : tree_(tree),
+      key_(key.begin(), key.end()),
+      size_(size),
+      inline_size_(size),
+      position_(0),
+      first_page_(0),
+      pages_count_(0),
+      is_committed_(false)
+    {
+        if(key.size() > tree_.max_key_size_)
+        {
+            throw common::MkvDBException("The key is too large.");
+        }
+        if(size > UINT32_MAX)
+        {
+            throw common::MkvDBException("The value is too large.");
+        }
+
+        if(key.size() + size <= tree_.max_key_value_size_)
+        {
+            cell_value_.resize(size);
+            return;
+        }
+
+        // The extent is made of whole pages, so the remainder of the value that would only
+        // partially fill its last page is kept in the cell when it is small enough.
+        auto page_size  = tree_.pager_.page_size();
+        auto max_inline = std::min<common::FileOffset>(
+          tree_.max_key_value_size_ - key.size() - OverflowReference::REFERENCE_SIZE,
+          tree_.max_key_value_size_ / 4);
+        auto remainder  = size % page_size;
+        inline_size_    = remainder <= max_inline ? remainder : 0;
+
+        auto overflow_size = static_cast<common::ValueSize>(size - inline_size_);
+        auto pages =
+          tree_.pager_.GetNewPages(OverflowReference::CountPages(overflow_size, page_size));
+        first_page_  = pages.front()->index();
+        pages_count_ = static_cast<pager::Page::PageIndex>(pages.size());
+
+        cell_value_.resize(OverflowReference::REFERENCE_SIZE + inline_size_);
+        OverflowReference::Write(cell_value_, first_page_, overflow_size);
+    }
+
+    ValueWriter::~ValueWriter()
+    {
+        if(!is_committed_ && pages_count_ > 0)
+        {
+            tree_.pager_.FreePages(first_page_, pages_count_);
+        }
+    }
+
+    void ValueWriter::Write(common::ConstByteSpan data)
+    {
+        assert(!is_committed_);
+
+        if(data.size() > size_ - position_)
+        {
+            throw common::MkvDBException("The data written goes past the end of the value.");
+        }
+
+        if(position_ < inline_size_)
+        {
+            auto size = std::min<std::size_t>(data.size(), inline_size_ - position_);
+            std::copy_n(data.begin(), size, cell_value_.begin() + inline_offset() + position_);
+            data = data.subspan(size);
+            position_ += size;
+        }
+
+        auto page_size = tree_.pager_.page_size();
+        while(!data.empty())
+        {
+            auto offset      = position_ - inline_size_;
+            auto page        = tree_.pager_.GetPage(
+              static_cast<pager::Page::PageIndex>(first_page_ + offset / page_size));
+            auto page_offset = offset % page_size;
+            auto size        = std::min<std::size_t>(data.size(), page_size - page_offset);
+            std::copy_n(data.begin(), size, page->data().begin() + page_offset);
+            page->MarkAsModified();
+            data = data.subspan(size);
+            position_ += size;
+        }
+    }
+
+    void ValueWriter::Commit()
+    {
+        assert(!is_committed_);
+
+        if(position_ != size_)
+        {
+            throw common::MkvDBException("The value is not completely written.");
+        }
+
+        tree_.PutCell(key_, cell_value_, pages_count_ > 0);
+        is_committed_ = true;
+    }
+
+    common::FileOffset ValueWriter::inline_offset() const
+    {
+        return pages_count_ > 0 ? OverflowReference::REFERENCE_SIZE : 0;
+    }
+} // namespace mkvdb::btree
\ No newline at end of file
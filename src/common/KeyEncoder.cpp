@@ -0,0 +1,88 @@
+#include "mkvdb/common/KeyEncoder.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+
+#include <algorithm>
+
+namespace mkvdb::common
+{
+    namespace
+    {
+        /// Byte starting an escape sequence or the end marker of a string.
+        constexpr std::byte ESCAPE = std::byte { 0x00 };
+
+        /// Byte following ESCAPE for an escaped 0x00 byte.
+        constexpr std::byte ESCAPED_ZERO = std::byte { 0xFF };
+
+        /// Byte following ESCAPE at the end of a string. It is lower than any byte that can
+        /// follow the end of a shorter string in a longer one.
+        constexpr std::byte TERMINATOR = std::byte { 0x01 };
+    } // namespace
+
+    KeyEncoder& KeyEncoder::Add(std::string_view value)
+    {
+        return AddBytes(ConstByteSpan(reinterpret_cast<const std::byte*>(value.data()),
+                                      value.size()));
+    }
+
+    KeyEncoder& KeyEncoder::AddBytes(ConstByteSpan value)
+    {
+        buffer_.reserve(buffer_.size() + value.size() + 2);
+        auto begin = value.begin();
+        for(;;)
+        {
+            auto zero = std::find(begin, value.end(), ESCAPE);
+            buffer_.insert(buffer_.end(), begin, zero);
+            if(zero == value.end())
+            {
+                break;
+            }
+            buffer_.push_back(ESCAPE);
+            buffer_.push_back(ESCAPED_ZERO);
+            begin = zero + 1;
+        }
+        buffer_.push_back(ESCAPE);
+        buffer_.push_back(TERMINATOR);
+        return *this;
+    }
+
+    KeyDecoder::KeyDecoder(ConstByteSpan key)
+    : key_(key),
+      position_(0)
+    {
+    }
+
+    std::vector<std::byte> KeyDecoder::ReadBytes()
+    {
+        std::vector<std::byte> value;
+        for(;;)
+        {
+            auto rest = key_.subspan(position_);
+            auto zero = std::find(rest.begin(), rest.end(), ESCAPE);
+            value.insert(value.end(), rest.begin(), zero);
+            position_ += zero - rest.begin();
+
+            auto escape = Take(2);
+            if(escape[1] == TERMINATOR)
+            {
+                return value;
+            }
+            if(escape[1] != ESCAPED_ZERO)
+            {
+                throw MkvDBException("Invalid escape sequence in an encoded key.");
+            }
+            value.push_back(ESCAPE);
+        }
+    }
+
+    ConstByteSpan KeyDecoder::Take(std::size_t size)
+    {
+        if(key_.size() - position_ < size)
+        {
+            throw MkvDBException("The encoded key is too short.");
+        }
+        auto bytes = key_.subspan(position_, size);
+        position_ += size;
+        return bytes;
+    }
+} // namespace mkvdb::common
\ No newline at end of file
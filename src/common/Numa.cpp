@@ -0,0 +1,81 @@
+#include "mkvdb/common/Numa.hpp"
+
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#    include <sched.h>
+#endif
+
+#if defined(MKVDB_HAS_LIBNUMA)
+#    include <numa.h>
+#endif
+
+namespace mkvdb::common
+{
+    std::size_t NumaNodesCount()
+    {
+#if defined(MKVDB_HAS_LIBNUMA)
+        static const std::size_t nodes_count =
+          numa_available() < 0 ? 1 : static_cast<std::size_t>(numa_max_node()) + 1;
+        return nodes_count;
+#else
+        return 1;
+#endif
+    }
+
+    std::size_t CurrentNumaNode()
+    {
+#if defined(MKVDB_HAS_LIBNUMA) && defined(__linux__)
+        unsigned int cpu;
+        unsigned int node;
+        if(getcpu(&cpu, &node) == 0 && node < NumaNodesCount())
+        {
+            return node;
+        }
+#endif
+        return 0;
+    }
+
+    std::byte* AllocateOnNumaNode(std::size_t size, std::size_t node)
+    {
+        void* memory = nullptr;
+
+#if defined(MKVDB_HAS_LIBNUMA)
+        if(node != ANY_NUMA_NODE && NumaNodesCount() > 1)
+        {
+            memory = numa_alloc_onnode(size, static_cast<int>(node));
+            if(memory == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+        }
+#endif
+
+        if(memory == nullptr)
+        {
+            memory = ::operator new(size);
+        }
+
+        // Touching the memory here also places the pages on the node of the calling thread when
+        // the memory is not explicitly bound to a node.
+        std::memset(memory, 0, size);
+        return static_cast<std::byte*>(memory);
+    }
+
+    void FreeNumaMemory(std::byte* memory, std::size_t size, std::size_t node)
+    {
+#if defined(MKVDB_HAS_LIBNUMA)
+        if(node != ANY_NUMA_NODE && NumaNodesCount() > 1)
+        {
+            numa_free(memory, size);
+            return;
+        }
+#else
+        (void) size;
+        (void) node;
+#endif
+
+        ::operator delete(memory);
+    }
+} // namespace mkvdb::common
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "mkvdb/common/ThreadPool.hpp"
+
+#include <cassert>
+
+namespace mkvdb::common
+{
+    ThreadPool::ThreadPool(std::size_t threads_count)
+    : is_stopping_(false)
+    {
+        assert(threads_count > 0);
+
+        threads_.reserve(threads_count);
+        for(std::size_t x = 0; x < threads_count; ++x)
+        {
+            threads_.emplace_back(&ThreadPool::Work, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            is_stopping_ = true;
+        }
+        condition_.notify_all();
+
+        for(auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    std::future<void> ThreadPool::Submit(std::function<void()> task)
+    {
+        std::packaged_task<void()> packaged_task(std::move(task));
+        auto future = packaged_task.get_future();
+
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(std::move(packaged_task));
+        }
+        condition_.notify_one();
+
+        return future;
+    }
+
+    void ThreadPool::Work()
+    {
+        for(;;)
+        {
+            std::packaged_task<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                condition_.wait(lock, [this]() { return is_stopping_ || !tasks_.empty(); });
+
+                if(tasks_.empty())
+                {
+                    return;
+                }
+
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+
+            task();
+        }
+    }
+} // namespace mkvdb::common
\ No newline at end of file
@@ -6,12 +6,14 @@
 namespace mkvdb::fs::memory
 {
     MemoryFile::MemoryFile()
-    : is_opened_(false)
+    : is_opened_(false),
+      is_read_only_(false)
     {
     }
 
     MemoryFile::MemoryFile(common::ConstByteSpan data)
     : is_opened_(false),
+      is_read_only_(false),
       data_(data.begin(), data.end())
     {
     }
@@ -21,14 +23,15 @@ namespace mkvdb::fs::memory
         Open();
     }
 
-    void MemoryFile::Open()
+    void MemoryFile::Open(OpenMode mode)
     {
         if(is_opened_)
         {
             throw common::MkvDBException("Cannot open file, the file is already opened.");
         }
 
-        is_opened_ = true;
+        is_opened_    = true;
+        is_read_only_ = mode == OpenMode::ReadOnly;
     }
 
     void MemoryFile::Close()
@@ -60,6 +63,12 @@ namespace mkvdb::fs::memory
               "Cannot write to the file, the file is not opened.");
         }
 
+        if(is_read_only_)
+        {
+            throw common::MkvDBException(
+              "Cannot write to the file, the file is opened in read-only mode.");
+        }
+
         auto required_size = offset + buffer.size_bytes();
         if(data_.size() < required_size)
         {
@@ -88,6 +97,11 @@ namespace mkvdb::fs::memory
                   buffer.data());
     }
 
+    void MemoryFile::WillNeed(common::FileOffset, common::FileOffset)
+    {
+        // Nothing to do, the content is already in memory.
+    }
+
     void MemoryFile::Sync()
     {
         // Nothing to do.
@@ -12,7 +12,8 @@ namespace mkvdb::fs::posix
 {
     PosixFile::PosixFile(std::string_view filename)
     : filename_(filename),
-      fd_(INVALID_FD)
+      fd_(INVALID_FD),
+      is_read_only_(false)
     {
     }
 
@@ -41,24 +42,26 @@ namespace mkvdb::fs::posix
             common::ThrowFromErrno(
               "An error occured while creating the file: %2$s (%1$d).");
         }
-        fd_ = fd;
+        fd_           = fd;
+        is_read_only_ = false;
     }
 
-    void PosixFile::Open()
+    void PosixFile::Open(OpenMode mode)
     {
         if(fd_ != INVALID_FD)
         {
             throw common::MkvDBException("Cannot open file, the file is already opened.");
         }
 
-        int flags = O_RDWR;
+        int flags = mode == OpenMode::ReadOnly ? O_RDONLY : O_RDWR;
         int fd    = open(filename_.c_str(), flags);
         if(fd == -1)
         {
             common::ThrowFromErrno(
               "An error occured while opening the file: %2$s (%1$d).");
         }
-        fd_ = fd;
+        fd_           = fd;
+        is_read_only_ = mode == OpenMode::ReadOnly;
     }
 
     void PosixFile::Close()
@@ -101,13 +104,13 @@ namespace mkvdb::fs::posix
               "Cannot create write to file, the file is not opened.");
         }
 
-        auto result = lseek(fd_, offset, SEEK_SET);
-        if(result == -1)
+        if(is_read_only_)
         {
-            common::ThrowFromErrno("An error occured writing to the file : %2$s (%1$d).");
+            throw common::MkvDBException(
+              "Cannot write to the file, the file is opened in read-only mode.");
         }
 
-        auto bytes_written = write(fd_, buffer.data(), buffer.size_bytes());
+        auto bytes_written = pwrite(fd_, buffer.data(), buffer.size_bytes(), offset);
         if(bytes_written == -1)
         {
             common::ThrowFromErrno("An error occured writing to the file : %2$s (%1$d).");
@@ -127,14 +130,7 @@ namespace mkvdb::fs::posix
               "Cannot read from file, the file is not opened.");
         }
 
-        auto result = lseek(fd_, offset, SEEK_SET);
-        if(result == -1)
-        {
-            common::ThrowFromErrno(
-              "An error occured reading from the file : %2$s (%1$d).");
-        }
-
-        auto bytes_read = read(fd_, buffer.data(), buffer.size_bytes());
+        auto bytes_read = pread(fd_, buffer.data(), buffer.size_bytes(), offset);
         if(bytes_read == -1)
         {
             common::ThrowFromErrno(
@@ -147,6 +143,18 @@ namespace mkvdb::fs::posix
         }
     }
 
+    void PosixFile::WillNeed(common::FileOffset offset, common::FileOffset size)
+    {
+        if(fd_ == INVALID_FD)
+        {
+            throw common::MkvDBException("Cannot hint a future read, the file is not opened.");
+        }
+
+        // The advice is only a hint. If it fails the data will simply be read when needed, so the
+        // result is ignored.
+        posix_fadvise(fd_, offset, size, POSIX_FADV_WILLNEED);
+    }
+
     void PosixFile::Sync()
     {
         auto result = fsync(fd_);
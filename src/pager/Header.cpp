@@ -1,5 +1,6 @@
 #include "mkvdb/pager/Header.hpp"
 
+#include "mkvdb/common/MkvDBException.hpp"
 #include "mkvdb/common/Serialization.hpp"
 #include "mkvdb/common/Types.hpp"
 #include "mkvdb/common/log2.hpp"
@@ -10,20 +11,31 @@
 
 namespace mkvdb::pager
 {
-    const common::FileOffset Header::HEADER_SIZE =
-      Header::PAGES_COUNT_OFFSET + Header::PAGES_COUNT_SIZE;
+    const common::FileOffset Header::HEADER_SIZE = Header::ByteOrderField::END;
 
     const std::string Header::MAGIC_STRING = "mkvDB file v1";
 
     common::FileOffset Header::ReadPageSize(fs::IFile& file)
     {
-        std::array<std::byte, PAGE_SIZE_SIZE> buffer;
-        file.Read(buffer, PAGE_SIZE_OFFSET);
-        common::FileOffset log_2_page_size = common::Deserialize<std::uint8_t>(buffer);
+        std::array<std::byte, PageSizeField::END> buffer;
+        file.Read(buffer, 0);
+        common::FileOffset log_2_page_size = PageSizeField::Read(buffer);
         return 1 << log_2_page_size;
     }
 
-    void Header::Initialize(fs::IFile& file, Page::PageSize page_size)
+    std::endian Header::ReadByteOrder(fs::IFile& file)
+    {
+        std::array<std::byte, ByteOrderField::END> buffer;
+        file.Read(buffer, 0);
+        switch(ByteOrderField::Read(buffer))
+        {
+        case BIG_ENDIAN_VALUE: return std::endian::big;
+        case LITTLE_ENDIAN_VALUE: return std::endian::little;
+        default: throw common::MkvDBException("The byte order of the file is unknown.");
+        }
+    }
+
+    void Header::Initialize(fs::IFile& file, Page::PageSize page_size, std::endian byte_order)
     {
         assert(512 <= page_size && page_size <= 65536);
         assert((page_size & (page_size - 1)) == 0); // page_size must be a power of two.
@@ -38,13 +50,18 @@ namespace mkvdb::pager
         common::Serialize(MAGIC_STRING, magic_string_span);
 
         // Page size
-        auto page_size_span         = page_span.subspan(PAGE_SIZE_OFFSET, PAGE_SIZE_SIZE);
-        std::uint8_t log2_page_size = common::log2(page_size);
-        common::Serialize(log2_page_size, page_size_span);
+        PageSizeField::Write(page_span, static_cast<std::uint8_t>(common::log2(page_size)));
 
         // Pages count
-        auto page_count_span = page_span.subspan(PAGES_COUNT_OFFSET, PAGES_COUNT_SIZE);
-        common::Serialize(static_cast<std::uint32_t>(1), page_count_span);
+        PagesCountField::Write(page_span, 1);
+
+        // Free list
+        FirstFreePageField::Write(page_span, 0);
+
+        // Byte order
+        ByteOrderField::Write(page_span,
+                              byte_order == std::endian::little ? LITTLE_ENDIAN_VALUE
+                                                                : BIG_ENDIAN_VALUE);
 
         file.Write(page_span, 0);
     }
@@ -8,11 +8,13 @@
 
 namespace mkvdb::pager
 {
-    Page::Page(PageIndex index, PageSize size)
+    Page::Page(PageIndex index, PageSize size, std::size_t numa_node)
     : index_(index),
       size_(size),
       is_modified_(false),
-      data_(std::make_unique<std::byte[]>(size_))
+      is_read_only_(false),
+      byte_order_(std::endian::big),
+      data_(common::AllocateOnNumaNode(size_, numa_node), BufferDeleter { size_, numa_node })
     {
     }
 
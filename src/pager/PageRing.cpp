@@ -0,0 +1,72 @@
+#include "mkvdb/pager/PageRing.hpp"
+
+#include <cassert>
+#include <memory>
+
+namespace mkvdb::pager
+{
+    PageRing::PageRing(std::size_t capacity, Page::PageSize page_size)
+    : page_size_(page_size),
+      next_frame_(0),
+      frames_(capacity)
+    {
+        assert(capacity > 0);
+    }
+
+    std::shared_ptr<Page> PageRing::Find(Page::PageIndex index) const
+    {
+        for(const auto& frame : frames_)
+        {
+            if(frame && frame->index() == index)
+            {
+                return frame;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<Page> PageRing::Remove(Page::PageIndex index)
+    {
+        for(auto& frame : frames_)
+        {
+            if(frame && frame->index() == index)
+            {
+                std::shared_ptr<Page> page;
+                page.swap(frame);
+                return page;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<Page> PageRing::Acquire(Page::PageIndex index, std::shared_ptr<Page>& evicted)
+    {
+        auto& frame = frames_[next_frame_];
+        next_frame_ = (next_frame_ + 1) % frames_.size();
+
+        if(frame && frame.use_count() == 1 && !frame->is_modified())
+        {
+            frame->Recycle(index);
+            return frame;
+        }
+
+        evicted = frame;
+        frame   = std::make_shared<Page>(index, page_size_);
+        return frame;
+    }
+
+    void PageRing::Insert(std::shared_ptr<Page> page, std::shared_ptr<Page>& evicted)
+    {
+        auto& frame = frames_[next_frame_];
+        next_frame_ = (next_frame_ + 1) % frames_.size();
+
+        if(frame && (frame.use_count() > 1 || frame->is_modified()))
+        {
+            evicted = frame;
+        }
+
+        frame = std::move(page);
+    }
+} // namespace mkvdb::pager
\ No newline at end of file
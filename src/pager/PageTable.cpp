@@ -0,0 +1,115 @@
+#include "mkvdb/pager/PageTable.hpp"
+
+#include "mkvdb/common/Numa.hpp"
+
+#include <cassert>
+
+namespace mkvdb::pager
+{
+    PageTable::PageTable(NumaPolicy numa_policy)
+    : numa_policy_(numa_policy),
+      partitions_(numa_policy == NumaPolicy::Disabled ? 1 : common::NumaNodesCount()),
+      statistics_(partitions_.size())
+    {
+    }
+
+    std::size_t PageTable::NumaNodeFor(Page::PageIndex index) const
+    {
+        switch(numa_policy_)
+        {
+        case NumaPolicy::LocalNode: return LocalPartition();
+        case NumaPolicy::HashToNode: return index % partitions_.size();
+        default: return common::ANY_NUMA_NODE;
+        }
+    }
+
+    std::shared_ptr<Page> PageTable::Find(Page::PageIndex index) const
+    {
+        // With the hash policy, the partition of a page is known from its index. Otherwise the
+        // local partition is the most likely, but the page could have been loaded by a thread
+        // running on another node.
+        std::size_t first_partition =
+          numa_policy_ == NumaPolicy::HashToNode ? index % partitions_.size() : LocalPartition();
+
+        auto it = partitions_[first_partition].find(index);
+        if(it != partitions_[first_partition].end())
+        {
+            return it->second;
+        }
+
+        if(numa_policy_ == NumaPolicy::LocalNode)
+        {
+            for(std::size_t partition = 0; partition < partitions_.size(); ++partition)
+            {
+                if(partition == first_partition)
+                {
+                    continue;
+                }
+
+                it = partitions_[partition].find(index);
+                if(it != partitions_[partition].end())
+                {
+                    return it->second;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    void PageTable::Insert(std::shared_ptr<Page> page)
+    {
+        // A second frame for the same page would be dropped while its caller keeps using it.
+        assert(!Contains(page->index()));
+
+        auto partition = PartitionOf(*page);
+        partitions_[partition].insert({ page->index(), std::move(page) });
+    }
+
+    std::size_t PageTable::size() const
+    {
+        std::size_t size = 0;
+        for(const auto& partition : partitions_)
+        {
+            size += partition.size();
+        }
+        return size;
+    }
+
+    void PageTable::RecordHit(const Page& page)
+    {
+        auto local = LocalPartition();
+        if(PartitionOf(page) == local)
+        {
+            ++statistics_[local].hits;
+        }
+        else
+        {
+            ++statistics_[local].remote_hits;
+        }
+    }
+
+    void PageTable::RecordMiss()
+    {
+        ++statistics_[LocalPartition()].misses;
+    }
+
+    std::size_t PageTable::LocalPartition() const
+    {
+        return numa_policy_ == NumaPolicy::Disabled ? 0
+                                                    : common::CurrentNumaNode() % partitions_.size();
+    }
+
+    std::size_t PageTable::PartitionOf(const Page& page) const
+    {
+        switch(numa_policy_)
+        {
+        case NumaPolicy::LocalNode:
+            // Pages created outside of the table (the frames of the sequential ring) are not
+            // allocated on a specific node. They are kept with the pages of the current node.
+            return page.numa_node() < partitions_.size() ? page.numa_node() : LocalPartition();
+        case NumaPolicy::HashToNode: return page.index() % partitions_.size();
+        default: return 0;
+        }
+    }
+} // namespace mkvdb::pager
\ No newline at end of file
@@ -1,54 +1,515 @@
 #include "mkvdb/pager/Pager.hpp"
 
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Serialization.hpp"
+
 #include "mkvdb/pager/Header.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <future>
 #include <memory>
 
 namespace mkvdb::pager
 {
-    Pager::Pager(fs::IFile& file)
-    : file_(file)
+    Pager::Pager(fs::IFile& file, NumaPolicy numa_policy)
+    : file_(file),
+      is_read_only_(file.is_read_only()),
+      page_table_(numa_policy)
     {
-        page_size_ = Header::ReadPageSize(file);
+        page_size_  = Header::ReadPageSize(file);
+        byte_order_ = Header::ReadByteOrder(file);
+
+        std::size_t ring_frames = SEQUENTIAL_RING_BYTES / page_size_;
+        if(ring_frames < SEQUENTIAL_RING_MIN_FRAMES)
+        {
+            ring_frames = SEQUENTIAL_RING_MIN_FRAMES;
+        }
+        sequential_ring_.emplace(ring_frames, page_size_);
+
+        Page::PageIndex readahead_window = READAHEAD_MAX_BYTES / page_size_;
+        if(readahead_window == 0)
+        {
+            readahead_window = 1;
+        }
+        readahead_.emplace(readahead_window);
+
         header_.emplace(GetPage(0));
     }
 
-    std::shared_ptr<Page> Pager::GetPage(Page::PageIndex index)
+    std::shared_ptr<Page> Pager::GetPage(Page::PageIndex index, AccessHint hint)
     {
         // Try to get the page from the cache.
-        auto it = pages_cache_.find(index);
-        if(it != pages_cache_.end())
+        if(auto page = page_table_.Find(index))
         {
-            return it->second;
+            page_table_.RecordHit(*page);
+            return page;
         }
 
-        // Read the file, add it to the cache and return it.
-        auto page = std::make_shared<Page>(index, page_size_);
-        file_.Read(page->data(), index * page_size_);
-        pages_cache_.insert({ index, page });
-        return page;
+        // The page might have been loaded by a sequential access. If it is now accessed normally
+        // it becomes part of the working set and is moved to the cache.
+        if(auto page = sequential_ring_->Find(index))
+        {
+            if(hint == AccessHint::Normal)
+            {
+                sequential_ring_->Remove(index);
+                page_table_.Insert(page);
+            }
+            page_table_.RecordHit(*page);
+            return page;
+        }
+
+        if(pending_reads_.contains(index))
+        {
+            auto page = CompletePendingRead(index, hint);
+            page_table_.RecordHit(*page);
+            return page;
+        }
+
+        page_table_.RecordMiss();
+        return ReadPages(index, hint);
     }
 
     std::shared_ptr<Page> Pager::GetNewPage()
     {
-        auto index = header_->pages_count();
-        header_->pages_count(index + 1);
+        if(is_read_only_)
+        {
+            throw common::MkvDBException("Cannot create a new page, the pager is read-only.");
+        }
 
-        auto page = std::make_shared<Page>(index, page_size_);
-        pages_cache_.insert({ index, page });
-        return page;
+        // Reuse the last page of the first extent of the free list if there is one, so the
+        // extent stays where it is.
+        if(auto index = header_->first_free_page(); index != 0)
+        {
+            auto page  = GetPage(index);
+            auto count = FreeExtentSizeField::Read(page->data());
+            if(count == 1)
+            {
+                header_->first_free_page(NextFreeExtentField::Read(page->data()));
+                return page;
+            }
+
+            FreeExtentSizeField::Write(page->data(), count - 1);
+            page->MarkAsModified();
+            return ReusePage(index + count - 1);
+        }
+
+        return GetNewPages(1).front();
+    }
+
+    std::vector<std::shared_ptr<Page>> Pager::GetNewPages(Page::PageIndex count)
+    {
+        if(is_read_only_)
+        {
+            throw common::MkvDBException("Cannot create new pages, the pager is read-only.");
+        }
+
+        std::vector<std::shared_ptr<Page>> pages;
+        pages.reserve(count);
+
+        // Look for the first extent of the free list that is large enough. The pages are taken
+        // from the end of the extent, unless it is used as a whole.
+        std::shared_ptr<Page> previous;
+        auto index = header_->first_free_page();
+        for(std::size_t x = 0; x < FREE_EXTENTS_SEARCH_LIMIT && index != 0; ++x)
+        {
+            auto page   = GetPage(index);
+            auto next   = NextFreeExtentField::Read(page->data());
+            auto extent = FreeExtentSizeField::Read(page->data());
+            if(extent == count)
+            {
+                if(previous)
+                {
+                    NextFreeExtentField::Write(previous->data(), next);
+                    previous->MarkAsModified();
+                }
+                else
+                {
+                    header_->first_free_page(next);
+                }
+
+                pages.push_back(page);
+                for(Page::PageIndex i = 1; i < count; ++i)
+                {
+                    pages.push_back(ReusePage(index + i));
+                }
+                return pages;
+            }
+
+            if(extent > count)
+            {
+                FreeExtentSizeField::Write(page->data(), extent - count);
+                page->MarkAsModified();
+                for(Page::PageIndex i = extent - count; i < extent; ++i)
+                {
+                    pages.push_back(ReusePage(index + i));
+                }
+                return pages;
+            }
+
+            previous = page;
+            index    = next;
+        }
+
+        auto first = header_->pages_count();
+        header_->pages_count(first + count);
+
+        for(Page::PageIndex new_index = first; new_index < first + count; ++new_index)
+        {
+            auto page =
+              std::make_shared<Page>(new_index, page_size_, page_table_.NumaNodeFor(new_index));
+            page->SetByteOrder(byte_order_);
+            page_table_.Insert(page);
+            pages.push_back(std::move(page));
+        }
+        return pages;
+    }
+
+    void Pager::FreePage(Page::PageIndex index)
+    {
+        FreePages(index, 1);
+    }
+
+    void Pager::FreePages(Page::PageIndex first, Page::PageIndex count)
+    {
+        if(is_read_only_)
+        {
+            throw common::MkvDBException("Cannot free pages, the pager is read-only.");
+        }
+        assert(0 < first && 0 < count && first + count <= header_->pages_count());
+
+        auto page = GetPage(first);
+        NextFreeExtentField::Write(page->data(), header_->first_free_page());
+        FreeExtentSizeField::Write(page->data(), count);
+        page->MarkAsModified();
+        header_->first_free_page(first);
+    }
+
+    void Pager::Prefetch(std::span<const Page::PageIndex> indexes, AccessHint hint)
+    {
+        auto end              = ReadablePagesEnd();
+        std::size_t max_pages   = READAHEAD_MAX_BYTES / page_size_;
+        std::size_t max_pending = std::max(PENDING_READS_MAX_BYTES / page_size_, max_pages);
+        std::size_t x           = 0;
+
+        while(x < indexes.size())
+        {
+            auto index = indexes[x++];
+            if(index >= end || IsLoaded(index))
+            {
+                continue;
+            }
+
+            // Consecutive indexes are read in a single request.
+            std::vector<std::shared_ptr<Page>> pages;
+            pages.push_back(
+              std::make_shared<Page>(index, page_size_, page_table_.NumaNodeFor(index)));
+            while(x < indexes.size() && indexes[x] == index + pages.size() && indexes[x] < end &&
+                  pages.size() < max_pages && !IsLoaded(indexes[x]))
+            {
+                auto next_index = indexes[x++];
+                pages.push_back(std::make_shared<Page>(next_index,
+                                                       page_size_,
+                                                       page_table_.NumaNodeFor(next_index)));
+            }
+
+            // The pages that are never requested are collected when too many pages are pending.
+            // Only if the finished reads are not enough does the caller wait for the others.
+            if(pending_reads_.size() + pages.size() > max_pending)
+            {
+                CompleteFinishedReads();
+                if(pending_reads_.size() + pages.size() > max_pending)
+                {
+                    CompletePendingReads();
+                }
+            }
+
+            for(const auto& page : pages)
+            {
+                page->SetByteOrder(byte_order_);
+                if(is_read_only_)
+                {
+                    page->MarkAsReadOnly();
+                }
+            }
+
+            if(!io_threads_)
+            {
+                io_threads_ = std::make_unique<common::ThreadPool>(PREFETCH_THREADS_COUNT);
+            }
+
+            // The task lives as long as its future, so it gives up its references to the pages
+            // once they are read. Otherwise the pages could not be recycled by the ring.
+            auto& file     = file_;
+            auto page_size = page_size_;
+            auto task      = [&file, page_size, pages]() mutable
+            { ReadBlock(file, page_size, std::move(pages)); };
+            auto done = io_threads_->Submit(task).share();
+
+            for(const auto& page : pages)
+            {
+                pending_reads_.insert({ page->index(), PendingRead { page, done, hint } });
+            }
+        }
     }
 
     void Pager::WriteModifiedPages()
     {
-        for(const auto& pair : pages_cache_)
+        if(is_read_only_)
+        {
+            throw common::MkvDBException("Cannot write the modified pages, the pager is read-only.");
+        }
+
+        // The file must not be modified while it's being read by the I/O threads.
+        CompletePendingReads();
+
+        page_table_.ForEach(
+          [this](const std::shared_ptr<Page>& page)
+          {
+              if(page->is_modified())
+              {
+                  WritePage(*page);
+              }
+          });
+
+        for(const auto& frame : sequential_ring_->frames())
         {
-            if(pair.second->is_modified())
+            if(frame && frame->is_modified())
             {
-                file_.Write(pair.second->data(), pair.second->index() * page_size_);
+                WritePage(*frame);
             }
         }
+
         file_.Sync();
     }
 
+    Page::PageIndex Pager::sequential_window() const
+    {
+        // A sequential access never has more than half of the ring in flight.
+        auto window = std::min<std::size_t>(READAHEAD_MAX_BYTES / page_size_,
+                                            sequential_ring_->capacity() / 2);
+        return static_cast<Page::PageIndex>(std::max<std::size_t>(window, 1));
+    }
+
+    std::shared_ptr<Page> Pager::ReadPages(Page::PageIndex index, AccessHint hint)
+    {
+        Page::PageIndex window = readahead_->OnRead(index);
+        if(hint == AccessHint::Sequential)
+        {
+            window = std::min(window, sequential_window());
+        }
+
+        auto count = CountReadablePages(index, window);
+        readahead_->OnPagesRead(index, count);
+
+        if(count == 1)
+        {
+            auto page = CreateFrame(index, hint);
+            file_.Read(page->data(), index * page_size_);
+            return page;
+        }
+
+        // Read all the pages in a single request and dispatch them into their frames.
+        readahead_buffer_.resize(count * page_size_);
+        file_.Read(readahead_buffer_, index * page_size_);
+
+        std::shared_ptr<Page> first_page;
+        for(Page::PageIndex x = 0; x < count; ++x)
+        {
+            auto page  = CreateFrame(index + x, hint);
+            auto begin = readahead_buffer_.begin() + x * page_size_;
+            std::copy(begin, begin + page_size_, page->data().begin());
+
+            if(x == 0)
+            {
+                first_page = page;
+            }
+        }
+
+        // Let the file start loading the next window while the caller works on these pages.
+        file_.WillNeed((index + count) * page_size_, readahead_->window() * page_size_);
+
+        return first_page;
+    }
+
+    Page::PageIndex Pager::CountReadablePages(Page::PageIndex index,
+                                              Page::PageIndex max_count) const
+    {
+        if(max_count <= 1)
+        {
+            return 1;
+        }
+
+        auto end              = ReadablePagesEnd();
+        Page::PageIndex count = 1;
+        while(count < max_count && index + count < end && !IsLoaded(index + count))
+        {
+            ++count;
+        }
+
+        return count;
+    }
+
+    bool Pager::IsLoaded(Page::PageIndex index) const
+    {
+        return page_table_.Contains(index) || pending_reads_.contains(index) ||
+               sequential_ring_->Find(index);
+    }
+
+    Page::PageIndex Pager::ReadablePagesEnd() const
+    {
+        return std::min<common::FileOffset>(header_->pages_count(), file_.size() / page_size_);
+    }
+
+    std::shared_ptr<Page> Pager::CompletePendingRead(Page::PageIndex index, AccessHint hint)
+    {
+        auto it      = pending_reads_.find(index);
+        auto pending = std::move(it->second);
+        pending_reads_.erase(it);
+
+        // If the read failed, the exception is thrown here and the page can be requested again.
+        pending.done.get();
+        if(hint == AccessHint::Sequential && pending.hint == AccessHint::Sequential)
+        {
+            InsertInRing(pending.page);
+        }
+        else
+        {
+            page_table_.Insert(pending.page);
+        }
+        return pending.page;
+    }
+
+    void Pager::CompletePendingReads()
+    {
+        for(const auto& [index, pending] : pending_reads_)
+        {
+            KeepPrefetchedPage(pending);
+        }
+        pending_reads_.clear();
+    }
+
+    void Pager::CompleteFinishedReads()
+    {
+        std::erase_if(pending_reads_,
+                      [this](const auto& entry)
+                      {
+                          const auto& pending = entry.second;
+                          if(pending.done.wait_for(std::chrono::seconds(0))
+                             != std::future_status::ready)
+                          {
+                              return false;
+                          }
+                          KeepPrefetchedPage(pending);
+                          return true;
+                      });
+    }
+
+    void Pager::KeepPrefetchedPage(const PendingRead& pending)
+    {
+        try
+        {
+            pending.done.get();
+            if(pending.hint == AccessHint::Normal)
+            {
+                page_table_.Insert(pending.page);
+            }
+        }
+        catch(const std::exception&)
+        {
+            // The page was only prefetched. It will be read again if it is requested.
+        }
+    }
+
+    void Pager::ReadBlock(fs::IFile& file,
+                          Page::PageSize page_size,
+                          std::vector<std::shared_ptr<Page>> pages)
+    {
+        auto offset = pages.front()->index() * page_size;
+        if(pages.size() == 1)
+        {
+            file.Read(pages.front()->data(), offset);
+            return;
+        }
+
+        std::vector<std::byte> buffer(pages.size() * page_size);
+        file.Read(buffer, offset);
+        for(std::size_t x = 0; x < pages.size(); ++x)
+        {
+            auto begin = buffer.begin() + x * page_size;
+            std::copy(begin, begin + page_size, pages[x]->data().begin());
+        }
+    }
+
+    std::shared_ptr<Page> Pager::ReusePage(Page::PageIndex index)
+    {
+        if(auto page = page_table_.Find(index))
+        {
+            return page;
+        }
+
+        if(auto page = sequential_ring_->Remove(index))
+        {
+            page_table_.Insert(page);
+            return page;
+        }
+
+        if(pending_reads_.contains(index))
+        {
+            return CompletePendingRead(index, AccessHint::Normal);
+        }
+
+        auto page = std::make_shared<Page>(index, page_size_, page_table_.NumaNodeFor(index));
+        page->SetByteOrder(byte_order_);
+        page_table_.Insert(page);
+        return page;
+    }
+
+    std::shared_ptr<Page> Pager::CreateFrame(Page::PageIndex index, AccessHint hint)
+    {
+        std::shared_ptr<Page> page;
+
+        // Frames of the ring that could not be recycled are kept in the cache so they are not
+        // lost.
+        if(hint == AccessHint::Sequential)
+        {
+            std::shared_ptr<Page> evicted;
+            page = sequential_ring_->Acquire(index, evicted);
+            if(evicted)
+            {
+                page_table_.Insert(evicted);
+            }
+        }
+        else
+        {
+            page = std::make_shared<Page>(index, page_size_, page_table_.NumaNodeFor(index));
+            page_table_.Insert(page);
+        }
+
+        page->SetByteOrder(byte_order_);
+        if(is_read_only_)
+        {
+            page->MarkAsReadOnly();
+        }
+
+        return page;
+    }
+
+    void Pager::InsertInRing(std::shared_ptr<Page> page)
+    {
+        std::shared_ptr<Page> evicted;
+        sequential_ring_->Insert(std::move(page), evicted);
+        if(evicted)
+        {
+            page_table_.Insert(evicted);
+        }
+    }
+
+    void Pager::WritePage(Page& page)
+    {
+        file_.Write(page.data(), page.index() * page_size_);
+        page.MarkAsUnmodified();
+    }
+
 } // namespace mkvdb::pager
\ No newline at end of file
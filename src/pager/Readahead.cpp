@@ -0,0 +1,35 @@
+#include "mkvdb/pager/Readahead.hpp"
+
+#include <cassert>
+
+namespace mkvdb::pager
+{
+    Readahead::Readahead(Page::PageIndex max_window)
+    : max_window_(max_window),
+      window_(1),
+      next_index_(0)
+    {
+        assert(max_window_ > 0);
+    }
+
+    Page::PageIndex Readahead::OnRead(Page::PageIndex index)
+    {
+        if(index == next_index_ && index != 0)
+        {
+            window_ = window_ < max_window_ / 2 ? window_ * 2 : max_window_;
+        }
+        else
+        {
+            window_ = 1;
+        }
+
+        return window_;
+    }
+
+    void Readahead::OnPagesRead(Page::PageIndex index, Page::PageIndex count)
+    {
+        // The header is read when the pager is opened. It doesn't start a sequential run, so the
+        // first page read after it is not read ahead.
+        next_index_ = index == 0 ? 0 : index + count;
+    }
+} // namespace mkvdb::pager
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "CountingFile.hpp"
+
+namespace mkvdb::tests
+{
+    CountingFile::CountingFile()
+    : reads_count_(0),
+      bytes_read_(0),
+      hints_count_(0)
+    {
+    }
+
+    void CountingFile::Read(common::ByteSpan buffer, common::FileOffset offset)
+    {
+        ++reads_count_;
+        bytes_read_ += buffer.size_bytes();
+        MemoryFile::Read(buffer, offset);
+    }
+
+    void CountingFile::WillNeed(common::FileOffset offset, common::FileOffset size)
+    {
+        ++hints_count_;
+        MemoryFile::WillNeed(offset, size);
+    }
+
+    void CountingFile::ResetCounters()
+    {
+        reads_count_ = 0;
+        bytes_read_  = 0;
+        hints_count_ = 0;
+    }
+} // namespace mkvdb::tests
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef MKVDB_TESTS_COUNTING_FILE_HPP_
+#define MKVDB_TESTS_COUNTING_FILE_HPP_
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace mkvdb::tests
+{
+    /// In memory file that counts the requests made to it. It can be used to validate the I/O
+    /// patterns of the upper layers. The counters can be updated from several threads.
+    class CountingFile : public fs::memory::MemoryFile
+    {
+    public:
+        /// Constructor
+        CountingFile();
+
+        /// Read a block of data from the file and increment the reads count.
+        void Read(common::ByteSpan buffer, common::FileOffset offset);
+
+        /// Register a hint and increment the hints count.
+        void WillNeed(common::FileOffset offset, common::FileOffset size);
+
+        /// Returns the number of reads since the creation of the file or the last reset.
+        inline std::size_t reads_count() const { return reads_count_; }
+
+        /// Returns the number of bytes read since the creation of the file or the last reset.
+        inline std::size_t bytes_read() const { return bytes_read_; }
+
+        /// Returns the number of hints received since the creation of the file or the last reset.
+        inline std::size_t hints_count() const { return hints_count_; }
+
+        /// Reset the counters.
+        void ResetCounters();
+
+    private:
+        std::atomic<std::size_t> reads_count_;
+        std::atomic<std::size_t> bytes_read_;
+        std::atomic<std::size_t> hints_count_;
+    };
+} // namespace mkvdb::tests
+
+#endif // MKVDB_TESTS_COUNTING_FILE_HPP_
\ No newline at end of file
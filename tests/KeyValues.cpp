@@ -0,0 +1,18 @@
+#include "KeyValues.hpp"
+
+#include "mkvdb/common/Serialization.hpp"
+
+namespace mkvdb::tests
+{
+    std::vector<std::byte> MakeKey(std::uint32_t value)
+    {
+        std::vector<std::byte> key(sizeof(value));
+        common::Serialize(value, key);
+        return key;
+    }
+
+    std::vector<std::byte> MakeValue(std::uint32_t value)
+    {
+        return std::vector<std::byte>(value % 48, static_cast<std::byte>(value));
+    }
+} // namespace mkvdb::tests
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef MKVDB_TESTS_KEY_VALUES_HPP_
+#define MKVDB_TESTS_KEY_VALUES_HPP_
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace mkvdb::tests
+{
+    /// Create a key whose byte order matches the order of an integer.
+    std::vector<std::byte> MakeKey(std::uint32_t value);
+
+    /// Create a value of a size that depends on an integer.
+    std::vector<std::byte> MakeValue(std::uint32_t value);
+
+    /// Returns the integers from 0 to count - 1 in a random order. The order is the same on each
+    /// call.
+    template<std::unsigned_integral Integer = std::uint32_t>
+    std::vector<Integer> ShuffledIntegers(std::type_identity_t<Integer> count)
+    {
+        std::vector<Integer> integers(count);
+        std::iota(integers.begin(), integers.end(), Integer(0));
+        std::shuffle(integers.begin(), integers.end(), std::mt19937(42));
+        return integers;
+    }
+} // namespace mkvdb::tests
+
+#endif // MKVDB_TESTS_KEY_VALUES_HPP_
\ No newline at end of file
@@ -0,0 +1,951 @@
+#include "mkvdb/btree/BTree.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Serialization.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../KeyValues.hpp"
+#include "../RandomBlob.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+namespace
+{
+    /// Returns the total number of page accesses recorded by a pager.
+    std::size_t CountPageAccesses(const pager::Pager& pager)
+    {
+        std::size_t count = 0;
+        for(const auto& statistics : pager.statistics())
+        {
+            count += statistics.hits + statistics.remote_hits + statistics.misses;
+        }
+        return count;
+    }
+
+} // namespace
+
+TEST_CASE("BTree::Get returns nothing on an empty tree")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+
+    auto actual = sut.Get(MakeKey(42));
+
+    REQUIRE_FALSE(actual.has_value());
+}
+
+TEST_CASE("BTree::Get returns the value previously put")
+{
+    RandomBlob key(12);
+    RandomBlob value(42);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+
+    sut.Put(key.data(), value.data());
+    auto actual = sut.Get(key.data());
+
+    REQUIRE(actual.has_value());
+    REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("BTree::Put replaces the value of a key already in the tree")
+{
+    const std::size_t new_value_size = GENERATE(12, 42, 64);
+
+    RandomBlob key(12);
+    RandomBlob value(42);
+    RandomBlob new_value(new_value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+
+    sut.Put(key.data(), value.data());
+    sut.Put(key.data(), new_value.data());
+    auto actual = sut.Get(key.data());
+
+    REQUIRE(actual.has_value());
+    REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(new_value.data()));
+}
+
+TEST_CASE("BTree::Put throws if the key is too large")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    RandomBlob small(4);
+    RandomBlob large_key(sut.max_key_size() + 1);
+
+    REQUIRE_THROWS_AS(sut.Put(large_key.data(), small.data()), common::MkvDBException);
+}
+
+TEST_CASE("BTree::Get returns a value stored in overflow pages")
+{
+    const std::size_t key_size   = GENERATE(4, 40);
+    const std::size_t value_size = GENERATE(100, 512, 10000, 100000, 100001, 100100);
+
+    RandomBlob key(key_size);
+    RandomBlob value(value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+
+    sut.Put(key.data(), value.data());
+    auto actual = sut.Get(key.data());
+
+    REQUIRE(actual.has_value());
+    REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("BTree::Get a large value does not add its overflow pages to the cache")
+{
+    const std::size_t value_size = 1024 * 1024;
+
+    RandomBlob key(8);
+    RandomBlob value(value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 4096);
+    pager::Page::PageIndex root_index;
+    {
+        pager::Pager pager(file);
+        root_index = BTree::Create(pager);
+        BTree tree(pager, root_index);
+        tree.Put(key.data(), value.data());
+        pager.WriteModifiedPages();
+    }
+    pager::Pager pager(file);
+    BTree sut(pager, root_index);
+    sut.Get(MakeKey(0));
+    auto expected = pager.cached_pages_count();
+
+    auto actual = sut.Get(key.data());
+    auto result = pager.cached_pages_count();
+
+    REQUIRE(actual.has_value());
+    REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(value.data()));
+    REQUIRE(expected == result);
+}
+
+TEST_CASE("BTree::Put many large values can all be read back after the tree is reopened")
+{
+    const std::uint32_t count = 300;
+    auto make_value           = [](std::uint32_t i)
+    { return std::vector<std::byte>(i * 37 % 3000, static_cast<std::byte>(i)); };
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Page::PageIndex root_index;
+    {
+        pager::Pager pager(file);
+        root_index = BTree::Create(pager);
+        BTree tree(pager, root_index);
+        for(auto i : ShuffledIntegers(count))
+        {
+            tree.Put(MakeKey(i), make_value(i));
+        }
+        pager.WriteModifiedPages();
+    }
+
+    pager::Pager pager(file);
+    BTree sut(pager, root_index);
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(make_value(i)));
+    }
+}
+
+TEST_CASE("BTree::Put the overflow pages of a replaced or deleted value are reused")
+{
+    const std::size_t value_size = 20 * 512;
+
+    RandomBlob key(8);
+    RandomBlob value(value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    sut.Put(key.data(), value.data());
+    pager.WriteModifiedPages();
+    auto size = file.size();
+
+    // The freed pages are reused by the small values and the nodes, so the file doesn't grow.
+    sut.Put(key.data(), RandomBlob(4).data());
+    REQUIRE(sut.Delete(key.data()));
+    for(std::uint32_t i = 0; i < 100; ++i)
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+    pager.WriteModifiedPages();
+
+    REQUIRE(sut.height() > 1);
+    REQUIRE(size == file.size());
+    for(std::uint32_t i = 0; i < 100; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+}
+
+TEST_CASE("BTree::Put a large value replaced in a loop does not grow the file")
+{
+    const std::size_t value_size = 20 * 512;
+
+    RandomBlob key(8);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    sut.Put(key.data(), RandomBlob(value_size).data());
+    sut.Put(key.data(), RandomBlob(value_size).data());
+    pager.WriteModifiedPages();
+    auto size = file.size();
+
+    // The new value is written before the old one is freed, so the pages of the previous value
+    // are reused each time.
+    for(std::uint32_t i = 0; i < 50; ++i)
+    {
+        sut.Put(key.data(), RandomBlob(value_size - i).data());
+    }
+    RandomBlob value(value_size);
+    sut.Put(key.data(), value.data());
+    pager.WriteModifiedPages();
+    auto actual = sut.Get(key.data());
+
+    REQUIRE(size == file.size());
+    REQUIRE(actual.has_value());
+    REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("BTree::Put many keys in random order can all be read back")
+{
+    const pager::Page::PageSize page_size = GENERATE(512, 4096);
+    const std::uint32_t count             = 5000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, page_size);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+
+    REQUIRE(sut.height() > 1);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+    REQUIRE_FALSE(sut.Get(MakeKey(count)).has_value());
+}
+
+TEST_CASE("BTree::Put keys of variable sizes are kept in order")
+{
+    const std::uint32_t count = 2000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    std::map<std::vector<std::byte>, std::vector<std::byte>> expected;
+    std::mt19937 generator(42);
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        std::vector<std::byte> key(generator() % sut.max_key_size() + 1);
+        std::generate(key.begin(), key.end(), [&] { return std::byte(generator() % 4); });
+        std::vector<std::byte> value(generator() % (sut.max_key_value_size() - key.size() + 1));
+        std::generate(value.begin(), value.end(), [&] { return std::byte(generator()); });
+
+        sut.Put(key, value);
+        expected[key] = value;
+    }
+
+    for(const auto& [key, value] : expected)
+    {
+        auto actual = sut.Get(key);
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(value));
+    }
+}
+
+TEST_CASE("BTree::Put keys sharing long prefixes can all be read back")
+{
+    const std::uint32_t count = 5000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    auto make_key = [](std::uint32_t i)
+    {
+        std::string prefix = "tenant-" + std::to_string(i % 3) + "/table-orders/row-";
+        std::vector<std::byte> key(prefix.size() + sizeof(i));
+        std::transform(
+          prefix.begin(), prefix.end(), key.begin(), [](char c) { return std::byte(c); });
+        common::Serialize(i, common::ByteSpan(key).subspan(prefix.size()));
+        return key;
+    };
+
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(make_key(i), MakeValue(i));
+    }
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(make_key(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+    REQUIRE_FALSE(sut.Get(make_key(count)).has_value());
+
+    // The nodes inside the tree are bounded by two separators and store their shared prefix.
+    pager.WriteModifiedPages();
+    std::size_t prefixed_nodes = 0;
+    for(pager::Page::PageIndex index = 1; index < file.size() / 512; ++index)
+    {
+        prefixed_nodes += Node(*pager.GetPage(index)).prefix().size() >= 20 ? 1 : 0;
+    }
+    REQUIRE(prefixed_nodes > 0);
+}
+
+TEST_CASE("BTree::Put the separators of the leaves are truncated")
+{
+    const std::uint32_t count    = 2000;
+    const std::size_t key_size   = 40;
+    const std::size_t value_size = 8;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        RandomBlob key(key_size);
+        RandomBlob value(value_size);
+        sut.Put(key.data(), value.data());
+    }
+
+    REQUIRE(sut.height() > 1);
+    Node root(*pager.GetPage(sut.root_index()));
+    std::vector<std::byte> separator;
+    for(NodeHeader::NodeSize i = 0; i < root.size(); ++i)
+    {
+        root.CopyKeyAt(i, separator);
+        REQUIRE(separator.size() < 8);
+    }
+}
+
+TEST_CASE("BTree::Delete returns false if the key is not in the tree")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    sut.Put(MakeKey(1), MakeValue(1));
+
+    auto actual = sut.Delete(MakeKey(2));
+
+    REQUIRE_FALSE(actual);
+}
+
+TEST_CASE("BTree::Delete removes only the deleted keys")
+{
+    const std::uint32_t count = 3000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+
+    for(std::uint32_t i = 0; i < count; i += 3)
+    {
+        REQUIRE(sut.Delete(MakeKey(i)));
+    }
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value() == (i % 3 != 0));
+    }
+}
+
+TEST_CASE("BTree::BTree a tree can be reopened after its pages are written")
+{
+    const std::uint32_t count    = 1000;
+    const std::endian byte_order = GENERATE(std::endian::big, std::endian::little);
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512, byte_order);
+    pager::Page::PageIndex root_index;
+    {
+        pager::Pager pager(file);
+        root_index = BTree::Create(pager);
+        BTree tree(pager, root_index);
+        for(auto i : ShuffledIntegers(count))
+        {
+            tree.Put(MakeKey(i), MakeValue(i));
+        }
+        pager.WriteModifiedPages();
+    }
+
+    pager::Pager pager(file);
+    BTree sut(pager, root_index);
+
+    REQUIRE(byte_order == pager.byte_order());
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+}
+
+TEST_CASE("BTree::Get touches a single page per level of the tree")
+{
+    const std::uint32_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+    auto height = sut.height();
+
+    auto before = CountPageAccesses(pager);
+    sut.Get(MakeKey(count / 2));
+    auto actual = CountPageAccesses(pager) - before;
+
+    REQUIRE(height == actual);
+    REQUIRE(height <= 6);
+}
+
+TEST_CASE("BTree point operations touch a number of pages proportional to the height",
+          "[.benchmark]")
+{
+    const std::uint32_t count      = GENERATE(1000, 10000, 100000);
+    const std::uint32_t operations = 1000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+    auto height = sut.height();
+
+    // The keys operated on are spread over the whole tree, so no path is favored.
+    auto keys = ShuffledIntegers(count);
+    keys.resize(operations);
+
+    std::size_t index = 0;
+    BENCHMARK("Get " + std::to_string(count) + " keys")
+    {
+        return sut.Get(MakeKey(keys[index++ % operations]));
+    };
+
+    auto before = CountPageAccesses(pager);
+    for(auto i : keys)
+    {
+        sut.Get(MakeKey(i));
+    }
+    auto get_touches = static_cast<double>(CountPageAccesses(pager) - before) / operations;
+
+    before = CountPageAccesses(pager);
+    for(auto i : keys)
+    {
+        sut.Put(MakeKey(i), MakeValue(i + 1));
+    }
+    auto put_touches = static_cast<double>(CountPageAccesses(pager) - before) / operations;
+
+    before = CountPageAccesses(pager);
+    for(auto i : keys)
+    {
+        sut.Delete(MakeKey(i));
+    }
+    auto delete_touches = static_cast<double>(CountPageAccesses(pager) - before) / operations;
+
+    WARN(count << " keys, height " << height << ", page touches per Get " << get_touches
+               << ", per Put " << put_touches << ", per Delete " << delete_touches);
+    REQUIRE(get_touches == height);
+    REQUIRE(put_touches <= 2 * height);
+    REQUIRE(delete_touches <= 2 * height);
+}
+
+TEST_CASE("BTree::MultiGet returns the values of the keys in the order of the keys")
+{
+    const std::uint32_t count = 3000;
+    auto make_value           = [](std::uint32_t i)
+    { return i % 100 == 0 ? std::vector<std::byte>(3000, std::byte{ 7 }) : MakeValue(i); };
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        if(i % 3 != 0)
+        {
+            sut.Put(MakeKey(i), make_value(i));
+        }
+    }
+
+    // Unsorted, missing, duplicated and out of range keys.
+    std::vector<std::vector<std::byte>> keys;
+    for(auto i : ShuffledIntegers(count + 100))
+    {
+        keys.push_back(MakeKey(i));
+        if(i % 7 == 0)
+        {
+            keys.push_back(MakeKey(i));
+        }
+    }
+    keys.emplace_back();
+    std::vector<common::ConstByteSpan> spans(keys.begin(), keys.end());
+
+    auto actual = sut.MultiGet(spans);
+
+    REQUIRE(actual.size() == keys.size());
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        auto expected = sut.Get(keys[i]);
+        REQUIRE(actual[i].has_value() == expected.has_value());
+        if(expected.has_value())
+        {
+            REQUIRE_THAT(*actual[i], Catch::Matchers::RangeEquals(*expected));
+        }
+    }
+}
+
+TEST_CASE("BTree::MultiGet returns nothing for no keys")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    sut.Put(MakeKey(1), MakeValue(1));
+
+    REQUIRE(sut.MultiGet({}).empty());
+}
+
+TEST_CASE("BTree::MultiGet touches each page of the paths of the keys once")
+{
+    const std::uint32_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+
+    // Consecutive keys share their leaves, so far fewer pages are touched than with a Get per key.
+    std::vector<std::vector<std::byte>> keys;
+    for(auto i : ShuffledIntegers(1000))
+    {
+        keys.push_back(MakeKey(count / 2 + i));
+    }
+    std::vector<common::ConstByteSpan> spans(keys.begin(), keys.end());
+
+    auto before = CountPageAccesses(pager);
+    auto values = sut.MultiGet(spans);
+    auto actual = CountPageAccesses(pager) - before;
+
+    REQUIRE(values.size() == keys.size());
+    REQUIRE(std::ranges::all_of(values, [](const auto& value) { return value.has_value(); }));
+    REQUIRE(actual < keys.size() / 2);
+    REQUIRE(actual >= sut.height());
+}
+
+TEST_CASE("BTree::Write applies the last operation of each key of the batch")
+{
+    const std::uint32_t count = 3000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Page::PageIndex root_index;
+    {
+        pager::Pager pager(file);
+        root_index = BTree::Create(pager);
+        BTree sut(pager, root_index);
+        for(std::uint32_t i = 0; i < count; i += 2)
+        {
+            sut.Put(MakeKey(i), MakeValue(i));
+        }
+        pager.WriteModifiedPages();
+
+        // Odd keys are put, multiples of 4 deleted, and multiples of 3 put twice then deleted.
+        WriteBatch batch;
+        for(auto i : ShuffledIntegers(count))
+        {
+            if(i % 3 == 0)
+            {
+                batch.Put(MakeKey(i), MakeValue(i + 1));
+            }
+            else if(i % 2 == 1)
+            {
+                batch.Put(MakeKey(i), MakeValue(i));
+            }
+            else if(i % 4 == 0)
+            {
+                batch.Delete(MakeKey(i));
+            }
+        }
+        for(std::uint32_t i = 0; i < count; i += 3)
+        {
+            batch.Put(MakeKey(i), std::vector<std::byte>(2000));
+            batch.Delete(MakeKey(i));
+        }
+
+        sut.Write(batch);
+    }
+
+    // The batch was written by BTree::Write.
+    pager::Pager pager(file);
+    BTree sut(pager, root_index);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        if(i % 3 == 0 || i % 4 == 0)
+        {
+            REQUIRE_FALSE(actual.has_value());
+        }
+        else
+        {
+            REQUIRE(actual.has_value());
+            REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+        }
+    }
+}
+
+TEST_CASE("BTree::Write leaves the tree unchanged if a key of the batch is too large")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    sut.Put(MakeKey(1), MakeValue(1));
+
+    WriteBatch batch;
+    batch.Delete(MakeKey(1));
+    batch.Put(MakeKey(2), MakeValue(2));
+    batch.Put(std::vector<std::byte>(sut.max_key_size() + 1), MakeValue(3));
+
+    REQUIRE_THROWS_AS(sut.Write(batch), common::MkvDBException);
+    REQUIRE(sut.Get(MakeKey(1)).has_value());
+    REQUIRE_FALSE(sut.Get(MakeKey(2)).has_value());
+}
+
+TEST_CASE("BTree::Put keys appended in increasing order fill the leaves")
+{
+    const std::uint32_t count = 20000;
+
+    auto file_size = [](const std::vector<std::uint32_t>& integers)
+    {
+        fs::memory::MemoryFile file;
+        file.Open();
+        pager::Header::Initialize(file, 512);
+        pager::Pager pager(file);
+        BTree sut(pager, BTree::Create(pager));
+        for(auto i : integers)
+        {
+            sut.Put(MakeKey(i), MakeValue(i));
+        }
+        pager.WriteModifiedPages();
+        return file.size();
+    };
+    std::vector<std::uint32_t> increasing(count);
+    std::iota(increasing.begin(), increasing.end(), 0);
+
+    auto append_size = file_size(increasing);
+    auto random_size = file_size(ShuffledIntegers(count));
+
+    REQUIRE(append_size * 10 < random_size * 8);
+}
+
+TEST_CASE("BTree::Put keys appended in increasing order skip the descent from the root")
+{
+    const std::uint32_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+    REQUIRE(sut.height() >= 3);
+
+    auto before = CountPageAccesses(pager);
+    for(std::uint32_t i = count; i < 2 * count; ++i)
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+    auto actual = CountPageAccesses(pager) - before;
+
+    REQUIRE(actual < count / 2);
+}
+
+TEST_CASE("BTree::Put appends mixed with other operations can all be read back")
+{
+    const std::uint32_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    std::map<std::uint32_t, std::vector<std::byte>> expected;
+    std::mt19937 random(42);
+    std::uint32_t last = 0;
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto operation = random() % 10;
+        if(operation < 6 || expected.empty())
+        {
+            last += 1 + random() % 3;
+            expected[last] = MakeValue(last);
+            sut.Put(MakeKey(last), expected[last]);
+        }
+        else if(operation < 8)
+        {
+            auto key      = static_cast<std::uint32_t>(random() % (last + 1));
+            expected[key] = MakeValue(key + 1);
+            sut.Put(MakeKey(key), expected[key]);
+        }
+        else
+        {
+            // Deleting the last key makes the next append go after a key that is not in the tree.
+            auto key = operation == 8 ? std::prev(expected.end())->first
+                                      : static_cast<std::uint32_t>(random() % (last + 1));
+            expected.erase(key);
+            sut.Delete(MakeKey(key));
+        }
+    }
+
+    for(std::uint32_t i = 0; i <= last; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        auto it     = expected.find(i);
+        REQUIRE(actual.has_value() == (it != expected.end()));
+        if(actual.has_value())
+        {
+            REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(it->second));
+        }
+    }
+}
+
+TEST_CASE("BTree::Put values replaced by values of other sizes reuse the space of the leaves")
+{
+    const std::uint32_t count = 2000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+    pager.WriteModifiedPages();
+    auto size = file.size();
+
+    // Each value alternates between two sizes, leaving a hole in its leaf at each replacement. A
+    // few leaves still split because some of the values grow.
+    for(std::uint32_t round = 1; round <= 4; ++round)
+    {
+        for(auto i : ShuffledIntegers(count))
+        {
+            sut.Put(MakeKey(i), MakeValue(i + round % 2));
+        }
+    }
+    pager.WriteModifiedPages();
+
+    REQUIRE(file.size() * 10 < size * 11);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+}
+
+TEST_CASE("BTree::Delete the pages of the merged nodes are reused")
+{
+    const std::uint32_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+    pager.WriteModifiedPages();
+    auto size = file.size();
+
+    for(auto i : ShuffledIntegers(count))
+    {
+        if(i % 10 != 0)
+        {
+            REQUIRE(sut.Delete(MakeKey(i)));
+        }
+    }
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        REQUIRE(sut.Get(MakeKey(i)).has_value() == (i % 10 == 0));
+    }
+
+    // The keys put back fill the pages freed by the merges.
+    for(auto i : ShuffledIntegers(count))
+    {
+        if(i % 10 != 0)
+        {
+            sut.Put(MakeKey(i), MakeValue(i));
+        }
+    }
+    pager.WriteModifiedPages();
+
+    REQUIRE(file.size() * 10 < size * 11);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+}
+
+TEST_CASE("BTree::Delete a tree whose keys are all deleted shrinks to a single leaf")
+{
+    const std::uint32_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), std::vector<std::byte>(i % 50 == 0 ? 3000 : 40));
+    }
+
+    for(auto i : ShuffledIntegers(count))
+    {
+        REQUIRE(sut.Delete(MakeKey(i)));
+    }
+
+    REQUIRE(1 == sut.height());
+    REQUIRE_FALSE(sut.Get(MakeKey(0)).has_value());
+}
+
+TEST_CASE("BTree::Delete alternate insertions and deletions at the limit of a merge are cheap")
+{
+    const std::uint32_t count  = 20000;
+    const std::uint32_t rounds = 1000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree sut(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakeKey(i), MakeValue(i));
+    }
+
+    // Delete the keys of a range until a deletion touches more pages than the path from the root
+    // to the leaf, which means the leaf was rebalanced with a sibling.
+    std::uint32_t key = count / 2;
+    for(;; ++key)
+    {
+        auto accesses = CountPageAccesses(pager);
+        REQUIRE(sut.Delete(MakeKey(key)));
+        if(CountPageAccesses(pager) - accesses > sut.height())
+        {
+            break;
+        }
+    }
+
+    // The leaf neither splits nor merges again, so each operation only touches the path.
+    auto before = CountPageAccesses(pager);
+    for(std::uint32_t i = 0; i < rounds; ++i)
+    {
+        sut.Put(MakeKey(key), MakeValue(key));
+        sut.Delete(MakeKey(key));
+    }
+    auto actual = CountPageAccesses(pager) - before;
+
+    REQUIRE(2 * rounds * sut.height() == actual);
+}
\ No newline at end of file
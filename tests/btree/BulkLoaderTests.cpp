@@ -0,0 +1,230 @@
+#include "mkvdb/btree/BulkLoader.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/Node.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Serialization.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../KeyValues.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+namespace
+{
+    /// Create a key sharing a long prefix with the other keys, whose byte order matches the
+    /// order of an integer.
+    std::vector<std::byte> MakePrefixedKey(std::uint32_t value)
+    {
+        std::string prefix = "table-orders/row-";
+        std::vector<std::byte> key(prefix.size() + sizeof(value));
+        std::transform(
+          prefix.begin(), prefix.end(), key.begin(), [](char c) { return std::byte(c); });
+        common::Serialize(value, common::ByteSpan(key).subspan(prefix.size()));
+        return key;
+    }
+} // namespace
+
+TEST_CASE("BulkLoader::Finish the keys added can all be read back")
+{
+    const std::uint32_t count = GENERATE(0, 1, 10, 20000);
+    const double fill_factor  = GENERATE(0.5, 0.9, 1.0);
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BulkLoader sut(pager, fill_factor);
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        sut.Add(MakePrefixedKey(2 * i), MakeValue(i));
+    }
+    BTree tree(pager, sut.Finish());
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = tree.Get(MakePrefixedKey(2 * i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+        REQUIRE_FALSE(tree.Get(MakePrefixedKey(2 * i + 1)).has_value());
+    }
+}
+
+TEST_CASE("BulkLoader::Finish the tree built can be modified")
+{
+    const std::uint32_t count = 10000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BulkLoader loader(pager);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        loader.Add(MakePrefixedKey(2 * i), MakeValue(i));
+    }
+    BTree sut(pager, loader.Finish());
+
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Put(MakePrefixedKey(2 * i + 1), MakeValue(i));
+        sut.Delete(MakePrefixedKey(2 * (count - 1 - i)));
+    }
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakePrefixedKey(2 * i + 1));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+        REQUIRE_FALSE(sut.Get(MakePrefixedKey(2 * i)).has_value());
+    }
+}
+
+TEST_CASE("BulkLoader::Finish the nodes are filled up to the fill factor")
+{
+    const std::uint32_t count = 20000;
+    const double fill_factor  = GENERATE(0.5, 0.7, 0.9);
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 4096);
+    pager::Pager pager(file);
+    BulkLoader sut(pager, fill_factor);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        sut.Add(MakePrefixedKey(i), MakeValue(i));
+    }
+    auto root_index = sut.Finish();
+
+    // The first leaf has no lower fence, so its cells use the whole space counted by the loader.
+    auto capacity = 4096 - NodeHeader::HEADER_SIZE;
+    auto page     = pager.GetPage(root_index);
+    while(!Node(*page).is_leaf())
+    {
+        page = pager.GetPage(Node(*page).ChildAt(0));
+    }
+    Node leaf(*page);
+    auto used = capacity - leaf.prefix().size() - leaf.free_space();
+
+    REQUIRE(used <= capacity * fill_factor);
+    REQUIRE(used >= capacity * fill_factor - 128);
+    REQUIRE(leaf.prefix().size() == 0);
+}
+
+TEST_CASE("BulkLoader::Finish the nodes inside the tree store the prefix shared by their fences")
+{
+    const std::uint32_t count = 5000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BulkLoader sut(pager);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        sut.Add(MakePrefixedKey(i), MakeValue(i));
+    }
+    auto root_index = sut.Finish();
+
+    std::size_t prefixed_nodes = 0;
+    for(pager::Page::PageIndex index = 1; index <= root_index; ++index)
+    {
+        prefixed_nodes += Node(*pager.GetPage(index)).prefix().size() >= 17 ? 1 : 0;
+    }
+    REQUIRE(prefixed_nodes > 0);
+}
+
+TEST_CASE("BulkLoader::Finish the last nodes of each level are balanced")
+{
+    const std::uint32_t count = GENERATE(range(1u, 3000u, 7u));
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BulkLoader sut(pager);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        sut.Add(MakePrefixedKey(i), MakeValue(i));
+    }
+    auto root_index = sut.Finish();
+
+    // Every node but the root uses at least a quarter of its space, like the nodes of a tree
+    // rebalanced after deletions, and every inner node has at least one key. The space is counted
+    // with the whole keys, like the loader counts it.
+    auto capacity = 512 - NodeHeader::HEADER_SIZE;
+    std::vector<pager::Page::PageIndex> pending{ root_index };
+    while(!pending.empty())
+    {
+        auto index = pending.back();
+        pending.pop_back();
+        Node node(*pager.GetPage(index));
+        if(index != root_index)
+        {
+            auto prefix_size = node.prefix().size();
+            auto used = capacity - node.free_space() - prefix_size + prefix_size * node.size();
+            REQUIRE(used >= capacity / 4);
+        }
+        if(!node.is_leaf())
+        {
+            REQUIRE(node.size() > 0);
+            for(NodeHeader::NodeSize pos = 0; pos <= node.size(); ++pos)
+            {
+                pending.push_back(node.ChildAt(pos));
+            }
+        }
+    }
+
+    BTree tree(pager, root_index);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        REQUIRE(tree.Get(MakePrefixedKey(i)).has_value());
+    }
+}
+
+TEST_CASE("BulkLoader::Add throws if the keys are not in increasing order")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BulkLoader sut(pager);
+    sut.Add(MakePrefixedKey(2), MakeValue(2));
+
+    REQUIRE_THROWS_AS(sut.Add(MakePrefixedKey(2), MakeValue(2)), common::MkvDBException);
+    REQUIRE_THROWS_AS(sut.Add(MakePrefixedKey(1), MakeValue(1)), common::MkvDBException);
+}
+
+TEST_CASE("BulkLoader::Add throws if the key or the key/value pair is too large")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    BulkLoader sut(pager);
+    std::vector<std::byte> small(4);
+    std::vector<std::byte> large_key(tree.max_key_size() + 1);
+    std::vector<std::byte> large_value(tree.max_key_value_size());
+
+    REQUIRE_THROWS_AS(sut.Add(large_key, small), common::MkvDBException);
+    REQUIRE_THROWS_AS(sut.Add(small, large_value), common::MkvDBException);
+}
\ No newline at end of file
@@ -65,3 +65,46 @@ TEST_CASE(
     REQUIRE_THAT(key.data(), Catch::Matchers::RangeEquals(actual_key));
     REQUIRE_THAT(value.data(), Catch::Matchers::RangeEquals(actual_value));
 }
+
+
+TEST_CASE("Cell::has_overflow the overflow flag is kept apart from the size of the key")
+{
+    const bool has_overflow = GENERATE(false, true);
+
+    RandomBlob key(12);
+    RandomBlob value(42);
+    auto required_size = Cell::CalculateRequiredSize(key.size(), value.size());
+    std::vector<std::byte> buffer(required_size);
+
+    Cell(buffer, key, value, has_overflow);
+    Cell sut(buffer);
+
+    REQUIRE(has_overflow == sut.has_overflow());
+    REQUIRE(required_size == Cell::ReadSize(buffer));
+    REQUIRE_THAT(key.data(), Catch::Matchers::RangeEquals(sut.key()));
+    REQUIRE_THAT(value.data(), Catch::Matchers::RangeEquals(sut.value()));
+}
+
+TEST_CASE("Cell::Cell the sizes are stored in the byte order of the cell")
+{
+    const std::endian byte_order = GENERATE(std::endian::big, std::endian::little);
+    const bool has_overflow      = GENERATE(false, true);
+
+    RandomBlob key(12);
+    RandomBlob value(42);
+    auto required_size = Cell::CalculateRequiredSize(key.size(), value.size());
+    std::vector<std::byte> buffer(required_size);
+
+    Cell(buffer, key, value, has_overflow, byte_order);
+    Cell sut(buffer, byte_order);
+
+    // The least significant byte of the key size is the first byte in little-endian order.
+    auto first = byte_order == std::endian::little ? std::byte(12)
+                 : has_overflow                    ? std::byte(0x80)
+                                                   : std::byte(0);
+    REQUIRE(first == buffer[0]);
+    REQUIRE(has_overflow == sut.has_overflow());
+    REQUIRE(required_size == Cell::ReadSize(buffer, byte_order));
+    REQUIRE_THAT(key.data(), Catch::Matchers::RangeEquals(sut.key()));
+    REQUIRE_THAT(value.data(), Catch::Matchers::RangeEquals(sut.value()));
+}
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include "mkvdb/btree/Cursor.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/BulkLoader.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../KeyValues.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+namespace
+{
+    /// Fixture with a tree holding the keys 0, 2, 4, ... put in a random order.
+    struct TreeFixture
+    {
+        static constexpr std::uint32_t COUNT = 5000;
+
+        TreeFixture()
+        {
+            file.Open();
+            pager::Header::Initialize(file, 512);
+            pager = std::make_unique<pager::Pager>(file);
+            tree  = std::make_unique<BTree>(*pager, BTree::Create(*pager));
+            for(auto i : ShuffledIntegers(COUNT))
+            {
+                tree->Put(MakeKey(2 * i), MakeValue(i));
+            }
+        }
+
+        fs::memory::MemoryFile file;
+        std::unique_ptr<pager::Pager> pager;
+        std::unique_ptr<BTree> tree;
+    };
+} // namespace
+
+TEST_CASE("Cursor::Next scans all the pairs in the order of the keys")
+{
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+
+    std::uint32_t i = 0;
+    for(bool valid = sut.SeekToFirst(); valid; valid = sut.Next())
+    {
+        REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * i)));
+        REQUIRE_THAT(sut.value(), Catch::Matchers::RangeEquals(MakeValue(i)));
+        ++i;
+    }
+
+    REQUIRE(TreeFixture::COUNT == i);
+    REQUIRE_FALSE(sut.is_valid());
+}
+
+TEST_CASE("Cursor::Prev scans all the pairs in the reverse order of the keys")
+{
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+
+    std::uint32_t i = TreeFixture::COUNT;
+    for(bool valid = sut.SeekToLast(); valid; valid = sut.Prev())
+    {
+        --i;
+        REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * i)));
+        REQUIRE_THAT(sut.value(), Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+
+    REQUIRE(0 == i);
+    REQUIRE_FALSE(sut.is_valid());
+}
+
+TEST_CASE("Cursor::Seek moves to the first key greater or equal to the key searched")
+{
+    const std::uint32_t searched = GENERATE(0, 1, 2, 999, 1000, 2 * 5000 - 2);
+
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+
+    auto actual = sut.Seek(MakeKey(searched));
+
+    auto expected = (searched + 1) / 2;
+    REQUIRE(actual);
+    REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * expected)));
+    REQUIRE_THAT(sut.value(), Catch::Matchers::RangeEquals(MakeValue(expected)));
+}
+
+TEST_CASE("Cursor::Seek returns false after the last key")
+{
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+
+    auto actual = sut.Seek(MakeKey(2 * TreeFixture::COUNT - 1));
+
+    REQUIRE_FALSE(actual);
+    REQUIRE_FALSE(sut.is_valid());
+}
+
+TEST_CASE("Cursor::Next and Cursor::Prev can be mixed")
+{
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+    sut.Seek(MakeKey(1000));
+
+    for(std::uint32_t i = 0; i < 300; ++i)
+    {
+        REQUIRE(sut.Next());
+    }
+    for(std::uint32_t i = 0; i < 500; ++i)
+    {
+        REQUIRE(sut.Prev());
+    }
+
+    REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(1000 - 2 * 200)));
+}
+
+TEST_CASE("Cursor::Next skips the leaves emptied by deletions")
+{
+    TreeFixture fixture;
+    for(std::uint32_t i = 100; i < 4000; ++i)
+    {
+        fixture.tree->Delete(MakeKey(2 * i));
+    }
+    Cursor sut(*fixture.tree);
+
+    REQUIRE(sut.Seek(MakeKey(2 * 99)));
+    REQUIRE(sut.Next());
+    REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * 4000)));
+    REQUIRE(sut.Prev());
+    REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * 99)));
+}
+
+TEST_CASE("Cursor::Next and Cursor::Prev follow the leaves merged by deletions")
+{
+    TreeFixture fixture;
+    std::vector<std::uint32_t> remaining;
+    for(auto i : ShuffledIntegers(TreeFixture::COUNT))
+    {
+        if(i % 7 == 0)
+        {
+            remaining.push_back(i);
+        }
+        else
+        {
+            fixture.tree->Delete(MakeKey(2 * i));
+        }
+    }
+    std::sort(remaining.begin(), remaining.end());
+    Cursor sut(*fixture.tree);
+
+    std::size_t x = 0;
+    for(bool valid = sut.SeekToFirst(); valid; valid = sut.Next())
+    {
+        REQUIRE(x < remaining.size());
+        REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * remaining[x++])));
+    }
+    REQUIRE(remaining.size() == x);
+    for(bool valid = sut.SeekToLast(); valid; valid = sut.Prev())
+    {
+        REQUIRE(x > 0);
+        REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * remaining[--x])));
+    }
+    REQUIRE(0 == x);
+}
+
+TEST_CASE("Cursor::SeekToFirst returns false on an empty tree")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    Cursor sut(tree);
+
+    REQUIRE_FALSE(sut.SeekToFirst());
+    REQUIRE_FALSE(sut.SeekToLast());
+}
+
+TEST_CASE("Cursor::value returns the values stored in overflow pages")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    std::vector<std::byte> large_value(5000, std::byte(42));
+    tree.Put(MakeKey(1), MakeValue(1));
+    tree.Put(MakeKey(2), large_value);
+    Cursor sut(tree);
+
+    REQUIRE(sut.Seek(MakeKey(2)));
+    REQUIRE_THAT(sut.value(), Catch::Matchers::RangeEquals(large_value));
+}
+
+TEST_CASE("Cursor::Next scans the leaves of a tree built by a bulk loader")
+{
+    const std::uint32_t count = 5000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BulkLoader loader(pager);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        loader.Add(MakeKey(i), MakeValue(i));
+    }
+    BTree tree(pager, loader.Finish());
+    Cursor sut(tree);
+
+    std::uint32_t i = 0;
+    for(bool valid = sut.SeekToFirst(); valid; valid = sut.Next())
+    {
+        REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(i)));
+        ++i;
+    }
+    REQUIRE(count == i);
+
+    for(bool valid = sut.SeekToLast(); valid; valid = sut.Prev())
+    {
+        --i;
+        REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(i)));
+    }
+    REQUIRE(0 == i);
+}
+
+TEST_CASE("Cursor::ScanBatch reads all the pairs in batches")
+{
+    const std::size_t max_rows = GENERATE(1, 7, 100, 10000);
+
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+    sut.SeekToFirst();
+    KeyValueBatch batch;
+
+    std::uint32_t i = 0;
+    while(sut.ScanBatch(batch, max_rows, 1024 * 1024) > 0)
+    {
+        REQUIRE(batch.size() <= max_rows);
+        for(std::size_t row = 0; row < batch.size(); ++row)
+        {
+            REQUIRE_THAT(batch.key(row), Catch::Matchers::RangeEquals(MakeKey(2 * i)));
+            REQUIRE_THAT(batch.value(row), Catch::Matchers::RangeEquals(MakeValue(i)));
+            ++i;
+        }
+    }
+
+    REQUIRE(TreeFixture::COUNT == i);
+    REQUIRE_FALSE(sut.is_valid());
+}
+
+TEST_CASE("Cursor::ScanBatch stops before the end of the range")
+{
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+    sut.Seek(MakeKey(1000));
+    KeyValueBatch batch;
+
+    auto actual = sut.ScanBatch(batch, 10000, 1024 * 1024, MakeKey(3001));
+
+    REQUIRE(1001 == actual);
+    REQUIRE_THAT(batch.key(0), Catch::Matchers::RangeEquals(MakeKey(1000)));
+    REQUIRE_THAT(batch.key(1000), Catch::Matchers::RangeEquals(MakeKey(3000)));
+    REQUIRE_FALSE(sut.is_valid());
+}
+
+TEST_CASE("Cursor::ScanBatch limits the size of a batch and continues after it")
+{
+    const common::FileOffset max_bytes = 1000;
+
+    TreeFixture fixture;
+    Cursor sut(*fixture.tree);
+    sut.SeekToFirst();
+    KeyValueBatch batch;
+
+    sut.ScanBatch(batch, 10000, max_bytes);
+
+    REQUIRE(batch.byte_size() <= max_bytes);
+    REQUIRE(batch.size() > 10);
+    REQUIRE(sut.is_valid());
+    REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(2 * batch.size())));
+}
+
+TEST_CASE("Cursor::ScanBatch reads the values stored in overflow pages")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    std::vector<std::byte> large_value(5000, std::byte(42));
+    tree.Put(MakeKey(1), MakeValue(1));
+    tree.Put(MakeKey(2), large_value);
+    tree.Put(MakeKey(3), MakeValue(3));
+    Cursor sut(tree);
+    sut.SeekToFirst();
+    KeyValueBatch batch;
+
+    sut.ScanBatch(batch, 10, 1024 * 1024);
+
+    REQUIRE(3 == batch.size());
+    REQUIRE_THAT(batch.value(0), Catch::Matchers::RangeEquals(MakeValue(1)));
+    REQUIRE_THAT(batch.value(1), Catch::Matchers::RangeEquals(large_value));
+    REQUIRE_THAT(batch.value(2), Catch::Matchers::RangeEquals(MakeValue(3)));
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "mkvdb/btree/ExternalSorter.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/BulkLoader.hpp"
+
+#include "mkvdb/common/Serialization.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../KeyValues.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+namespace
+{
+    /// Factory of temporary files in memory.
+    ExternalSorter::FileFactory MemoryFiles()
+    {
+        return []() { return std::make_unique<fs::memory::MemoryFile>(); };
+    }
+} // namespace
+
+TEST_CASE("ExternalSorter::Next returns the pairs in the order of their keys")
+{
+    const std::uint32_t count       = GENERATE(0, 1, 1000, 20000);
+    const std::size_t run_size      = GENERATE(1024, 64 * 1024, 16 * 1024 * 1024);
+    const std::size_t threads_count = GENERATE(1, 3);
+
+    ExternalSorter sut(MemoryFiles(), run_size, threads_count);
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Add(MakeKey(i), MakeValue(i));
+    }
+    sut.Finish();
+
+    std::uint32_t expected = 0;
+    while(sut.Next())
+    {
+        REQUIRE_THAT(sut.key(), Catch::Matchers::RangeEquals(MakeKey(expected)));
+        REQUIRE_THAT(sut.value(), Catch::Matchers::RangeEquals(MakeValue(expected)));
+        ++expected;
+    }
+    REQUIRE(count == expected);
+    REQUIRE_FALSE(sut.Next());
+}
+
+TEST_CASE("ExternalSorter::Finish the runs larger than the run size are spilled")
+{
+    const std::uint32_t count = 10000;
+
+    ExternalSorter sut(MemoryFiles(), 16 * 1024, 2);
+    for(auto i : ShuffledIntegers(count))
+    {
+        sut.Add(MakeKey(i), MakeValue(i));
+    }
+    sut.Finish();
+
+    REQUIRE(sut.spilled_runs_count() > 10);
+}
+
+TEST_CASE("ExternalSorter::Next returns the pairs with equal keys in the order they were added")
+{
+    const std::uint32_t count = 5000;
+
+    ExternalSorter sut(MemoryFiles(), 4096, 2);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        std::vector<std::byte> value(sizeof(i));
+        common::Serialize(i, value);
+        sut.Add(MakeKey(i % 7), value);
+    }
+    sut.Finish();
+
+    std::uint32_t previous_key   = 0;
+    std::uint32_t previous_value = 0;
+    std::uint32_t read_count     = 0;
+    while(sut.Next())
+    {
+        auto key   = common::Deserialize<std::uint32_t>(sut.key());
+        auto value = common::Deserialize<std::uint32_t>(sut.value());
+        REQUIRE(key == value % 7);
+        if(read_count > 0 && key == previous_key)
+        {
+            REQUIRE(previous_value < value);
+        }
+        previous_key   = key;
+        previous_value = value;
+        ++read_count;
+    }
+    REQUIRE(count == read_count);
+}
+
+TEST_CASE("ExternalSorter::Next the sorted pairs can be loaded in a tree")
+{
+    const std::uint32_t count = 20000;
+
+    ExternalSorter sorter(MemoryFiles(), 64 * 1024, 2);
+    for(auto i : ShuffledIntegers(count))
+    {
+        sorter.Add(MakeKey(i), MakeValue(i));
+    }
+    sorter.Finish();
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BulkLoader loader(pager);
+    while(sorter.Next())
+    {
+        loader.Add(sorter.key(), sorter.value());
+    }
+    BTree sut(pager, loader.Finish());
+
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        auto actual = sut.Get(MakeKey(i));
+        REQUIRE(actual.has_value());
+        REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(MakeValue(i)));
+    }
+}
\ No newline at end of file
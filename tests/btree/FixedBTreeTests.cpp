@@ -0,0 +1,159 @@
+#include "mkvdb/btree/FixedBTree.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../KeyValues.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+namespace
+{
+    using Uint64Tree = FixedBTree<std::uint64_t, std::uint64_t>;
+} // namespace
+
+TEST_CASE("FixedBTree::Get returns nothing on an empty tree")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    Uint64Tree sut(pager, Uint64Tree::Create(pager));
+
+    REQUIRE_FALSE(sut.Get(42).has_value());
+    REQUIRE(1 == sut.height());
+}
+
+TEST_CASE("FixedBTree::Put many keys in random order can all be read back after a reopen")
+{
+    const std::uint64_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Page::PageIndex root_index;
+    {
+        pager::Pager pager(file);
+        root_index = Uint64Tree::Create(pager);
+        Uint64Tree tree(pager, root_index);
+        for(auto i : ShuffledIntegers<std::uint64_t>(count))
+        {
+            tree.Put(i * 3, i);
+        }
+        pager.WriteModifiedPages();
+    }
+
+    pager::Pager pager(file);
+    Uint64Tree sut(pager, root_index);
+    for(std::uint64_t i = 0; i < count * 3; ++i)
+    {
+        auto actual = sut.Get(i);
+        REQUIRE(actual.has_value() == (i % 3 == 0));
+        if(actual.has_value())
+        {
+            REQUIRE(i / 3 == *actual);
+        }
+    }
+}
+
+TEST_CASE("FixedBTree::Put replaces and Delete removes the values of the keys")
+{
+    const std::uint64_t count = 5000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    Uint64Tree sut(pager, Uint64Tree::Create(pager));
+    std::map<std::uint64_t, std::uint64_t> expected;
+    std::mt19937 random(42);
+    for(std::uint64_t i = 0; i < 4 * count; ++i)
+    {
+        std::uint64_t key = random() % count;
+        if(random() % 3 == 0)
+        {
+            REQUIRE(sut.Delete(key) == (expected.erase(key) == 1));
+        }
+        else
+        {
+            sut.Put(key, i);
+            expected[key] = i;
+        }
+    }
+
+    for(std::uint64_t key = 0; key < count; ++key)
+    {
+        auto actual = sut.Get(key);
+        auto it     = expected.find(key);
+        REQUIRE(actual.has_value() == (it != expected.end()));
+        if(actual.has_value())
+        {
+            REQUIRE(it->second == *actual);
+        }
+    }
+}
+
+TEST_CASE("FixedBTree::Put keys appended in increasing order fill the leaves")
+{
+    const std::uint64_t count = 20000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    Uint64Tree sut(pager, Uint64Tree::Create(pager));
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        sut.Put(i, i);
+    }
+    pager.WriteModifiedPages();
+
+    auto capacity = Uint64Tree::FixedNodeType::Capacity(pager.page_size(),
+                                                         NodeHeader::NodeType::FixedLeaf);
+    REQUIRE(file.size() / 512 < count / capacity * 11 / 10);
+    for(std::uint64_t i = 0; i < count; ++i)
+    {
+        REQUIRE(i == sut.Get(i));
+    }
+}
+
+TEST_CASE("FixedBTree::FixedBTree throws if the page is not the root of a fixed-size tree")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+
+    REQUIRE_THROWS_AS(Uint64Tree(pager, BTree::Create(pager)), common::MkvDBException);
+}
+
+TEST_CASE("FixedBTree::FixedBTree throws if the tree was created with other key or value sizes")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    auto root_index = Uint64Tree::Create(pager);
+
+    REQUIRE_NOTHROW(Uint64Tree(pager, root_index));
+    REQUIRE_THROWS_AS((FixedBTree<std::uint32_t, std::uint64_t>(pager, root_index)),
+                      common::MkvDBException);
+    REQUIRE_THROWS_AS((FixedBTree<std::uint64_t, std::uint32_t>(pager, root_index)),
+                      common::MkvDBException);
+}
\ No newline at end of file
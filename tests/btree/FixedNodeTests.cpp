@@ -0,0 +1,145 @@
+#include "mkvdb/btree/FixedNode.hpp"
+
+#include "mkvdb/btree/Node.hpp"
+
+#include "mkvdb/common/Serialization.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+
+namespace
+{
+    using Uint64Node = FixedNode<std::uint64_t, std::uint64_t>;
+} // namespace
+
+TEST_CASE("FixedNode::Insert Keys inserted in any order are kept sorted.")
+{
+    pager::Page page(1, 512);
+    Uint64Node sut(page);
+    sut.InitializeNewNode();
+
+    for(std::uint64_t key : { 50, 10, 40, 20, 30 })
+    {
+        sut.Insert(sut.LowerBound(key), key, key * 2);
+    }
+
+    REQUIRE(5 == sut.size());
+    for(NodeHeader::NodeSize i = 0; i < sut.size(); ++i)
+    {
+        REQUIRE(10u * (i + 1) == sut.KeyAt(i));
+        REQUIRE(20u * (i + 1) == sut.ValueAt(i));
+    }
+    REQUIRE(page.is_modified());
+}
+
+TEST_CASE("FixedNode::LowerBound Returns the position of the first key greater or equal.")
+{
+    pager::Page page(1, 4096);
+    FixedNode<std::uint32_t, std::uint32_t> sut(page);
+    sut.InitializeNewNode();
+    const std::uint32_t count = GENERATE(0, 1, 2, 7, 100);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        sut.Insert(sut.size(), 2 * i + 1, i);
+    }
+
+    for(std::uint32_t key = 0; key <= 2 * count + 1; ++key)
+    {
+        REQUIRE(std::min(key / 2, count) == sut.LowerBound(key));
+    }
+}
+
+TEST_CASE("FixedNode::Erase The other pairs can still be read.")
+{
+    pager::Page page(1, 512);
+    Uint64Node sut(page);
+    sut.InitializeNewNode();
+    for(std::uint64_t i = 0; i < 3; ++i)
+    {
+        sut.Insert(sut.size(), i, 10 + i);
+    }
+
+    sut.Erase(1);
+
+    REQUIRE(2 == sut.size());
+    REQUIRE(0 == sut.KeyAt(0));
+    REQUIRE(10 == sut.ValueAt(0));
+    REQUIRE(2 == sut.KeyAt(1));
+    REQUIRE(12 == sut.ValueAt(1));
+}
+
+TEST_CASE("FixedNode::InsertChild The children of an inner node follow their separators.")
+{
+    pager::Page page(1, 512);
+    Uint64Node sut(page);
+    sut.InitializeNewNode(NodeHeader::NodeType::FixedInner);
+    sut.SetChildAt(0, 100);
+
+    sut.InsertChild(0, 20, 102);
+    sut.InsertChild(0, 10, 101);
+
+    REQUIRE_FALSE(sut.is_leaf());
+    REQUIRE(2 == sut.size());
+    REQUIRE(100 == sut.ChildAt(0));
+    REQUIRE(101 == sut.ChildAt(1));
+    REQUIRE(102 == sut.ChildAt(2));
+    REQUIRE(0 == sut.FindChildPosition(9));
+    REQUIRE(1 == sut.FindChildPosition(10));
+    REQUIRE(1 == sut.FindChildPosition(19));
+    REQUIRE(2 == sut.FindChildPosition(20));
+}
+
+TEST_CASE("FixedNode::MoveTail The separator of inner nodes is not moved.")
+{
+    pager::Page page(1, 512);
+    pager::Page right_page(2, 512);
+    Uint64Node sut(page);
+    Uint64Node right(right_page);
+    sut.InitializeNewNode(NodeHeader::NodeType::FixedInner);
+    right.InitializeNewNode(NodeHeader::NodeType::FixedInner);
+    sut.SetChildAt(0, 100);
+    for(std::uint64_t i = 1; i <= 5; ++i)
+    {
+        sut.InsertChild(sut.size(), 10 * i, 100 + i);
+    }
+
+    sut.MoveTail(2, right);
+
+    REQUIRE(2 == sut.size());
+    REQUIRE(20 == sut.KeyAt(1));
+    REQUIRE(102 == sut.ChildAt(2));
+    REQUIRE(2 == right.size());
+    REQUIRE(40 == right.KeyAt(0));
+    REQUIRE(50 == right.KeyAt(1));
+    REQUIRE(103 == right.ChildAt(0));
+    REQUIRE(105 == right.ChildAt(2));
+}
+
+TEST_CASE("FixedNode::Capacity Holds nearly twice as many pairs as a Node.")
+{
+    const pager::Page::PageSize page_size = 4096;
+
+    pager::Page page(1, page_size);
+    Node node(page);
+    node.InitializeNewNode();
+    std::array<std::byte, sizeof(std::uint64_t)> key;
+    std::array<std::byte, sizeof(std::uint64_t)> value{};
+    std::uint64_t count = 0;
+    while(node.CanInsert(key.size(), value.size()))
+    {
+        common::Serialize(count++, key);
+        node.Insert(node.size(), key, value);
+    }
+
+    auto actual = Uint64Node::Capacity(page.content().size(), NodeHeader::NodeType::FixedLeaf);
+
+    REQUIRE((page.content().size() - NodeHeader::HEADER_SIZE) / 16 == actual);
+    REQUIRE(actual * 10 >= count * 18);
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "mkvdb/btree/HeadSearch.hpp"
+
+#include "mkvdb/common/Serialization.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+
+TEST_CASE("MakeHead The head of a short key is padded with zeros")
+{
+    std::array<std::byte, 2> key = { std::byte { 0x12 }, std::byte { 0x34 } };
+
+    auto actual = MakeHead(key);
+
+    REQUIRE(0x12340000 == actual);
+}
+
+TEST_CASE("MakeHead The head of a long key contains its first bytes")
+{
+    std::array<std::byte, 6> key = { std::byte { 0x12 }, std::byte { 0x34 }, std::byte { 0x56 },
+                                     std::byte { 0x78 }, std::byte { 0x9a }, std::byte { 0xbc } };
+
+    auto actual = MakeHead(key);
+
+    REQUIRE(0x12345678 == actual);
+}
+
+TEST_CASE("CountHeadsLessThan Returns the same count as a scalar search")
+{
+    const std::size_t count = GENERATE(range(0, 40), 64, 65, 127);
+
+    std::mt19937 generator(static_cast<std::uint32_t>(count));
+    std::vector<std::uint32_t> values(count);
+    std::generate(values.begin(), values.end(), [&] { return generator(); });
+    values.push_back(0);
+    values.push_back(UINT32_MAX);
+    values.push_back(0x80000000);
+    std::sort(values.begin(), values.end());
+    std::vector<std::byte> heads(values.size() * HEAD_SIZE);
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        common::Serialize(values[i], common::ByteSpan(heads).subspan(i * HEAD_SIZE, HEAD_SIZE));
+    }
+
+    for(auto searched : values)
+    {
+        for(auto head : { searched, searched + 1, searched - 1 })
+        {
+            auto expected = static_cast<std::size_t>(
+              std::lower_bound(values.begin(), values.end(), head) - values.begin());
+
+            auto actual = CountHeadsLessThan(heads.data(), values.size(), head);
+
+            REQUIRE(expected == actual);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "mkvdb/btree/InterleavedLookup.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+#include "mkvdb/btree/BulkLoader.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../KeyValues.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+namespace
+{
+    /// Create a value of a size that depends on an integer. Some values are stored in overflow
+    /// pages.
+    std::vector<std::byte> MakeValueWithOverflows(std::uint32_t value)
+    {
+        std::vector<std::byte> result(value % 100 == 0 ? 2000 : value % 48,
+                                      static_cast<std::byte>(value));
+        return result;
+    }
+
+    /// Check that the lookups of the keys from 0 to count + 49, of a duplicated key and of the
+    /// empty key return the same values as BTree::Get.
+    void CheckLookups(const BTree& tree, std::size_t group_size, std::uint32_t count)
+    {
+        std::vector<std::vector<std::byte>> keys;
+        for(auto i : ShuffledIntegers(count + 50))
+        {
+            keys.push_back(MakeKey(i));
+        }
+        keys.push_back(MakeKey(10));
+        keys.emplace_back();
+        std::vector<common::ConstByteSpan> spans(keys.begin(), keys.end());
+
+        InterleavedLookup sut(tree, group_size);
+        auto actual = sut.Get(spans);
+
+        REQUIRE(actual.size() == keys.size());
+        for(std::size_t i = 0; i < keys.size(); ++i)
+        {
+            auto expected = tree.Get(keys[i]);
+            REQUIRE(actual[i].has_value() == expected.has_value());
+            if(expected.has_value())
+            {
+                REQUIRE_THAT(*actual[i], Catch::Matchers::RangeEquals(*expected));
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("InterleavedLookup::Get returns the values of the keys in the order of the keys")
+{
+    const std::uint32_t count = 4000;
+    auto group_size           = GENERATE(std::size_t{ 1 }, std::size_t{ 4 }, std::size_t{ 16 });
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    for(auto i : ShuffledIntegers(count))
+    {
+        if(i % 2 == 0)
+        {
+            tree.Put(MakeKey(i), MakeValueWithOverflows(i));
+        }
+    }
+
+    CheckLookups(tree, group_size, count);
+}
+
+TEST_CASE("InterleavedLookup::Get loads the pages of a tree read from the file")
+{
+    const std::uint32_t count = 4000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Page::PageIndex root_index;
+    {
+        pager::Pager pager(file);
+        root_index = BTree::Create(pager);
+        BTree tree(pager, root_index);
+        for(auto i : ShuffledIntegers(count))
+        {
+            if(i % 2 == 0)
+            {
+                tree.Put(MakeKey(i), MakeValueWithOverflows(i));
+            }
+        }
+        pager.WriteModifiedPages();
+    }
+
+    pager::Pager pager(file);
+    BTree tree(pager, root_index);
+
+    CheckLookups(tree, InterleavedLookup::DEFAULT_GROUP_SIZE, count);
+}
+
+TEST_CASE("InterleavedLookup::Get returns nothing for no keys")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    InterleavedLookup sut(tree);
+
+    REQUIRE(sut.Get({}).empty());
+}
+
+TEST_CASE("InterleavedLookup::Get compared with sequential BTree::Get on a large tree",
+          "[.benchmark]")
+{
+    // The tree is much larger than the CPU caches, so most node accesses of a lookup miss.
+    const std::uint32_t count   = GENERATE(100000, 1000000);
+    const std::uint32_t lookups = 10000;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 4096);
+    pager::Pager pager(file);
+    BulkLoader loader(pager);
+    for(std::uint32_t i = 0; i < count; ++i)
+    {
+        loader.Add(MakeKey(i), MakeValue(i));
+    }
+    BTree tree(pager, loader.Finish());
+
+    std::vector<std::vector<std::byte>> keys;
+    for(auto i : ShuffledIntegers(count))
+    {
+        keys.push_back(MakeKey(i));
+        if(keys.size() == lookups)
+        {
+            break;
+        }
+    }
+    std::vector<common::ConstByteSpan> spans(keys.begin(), keys.end());
+    InterleavedLookup sut(tree);
+
+    auto sequential = [&]()
+    {
+        std::size_t found = 0;
+        for(auto key : spans)
+        {
+            found += tree.Get(key).has_value();
+        }
+        return found;
+    };
+    auto interleaved = [&]()
+    {
+        std::size_t found = 0;
+        for(const auto& value : sut.Get(spans))
+        {
+            found += value.has_value();
+        }
+        return found;
+    };
+
+    const auto suffix = " " + std::to_string(lookups) + " of " + std::to_string(count) + " keys";
+    BENCHMARK("Sequential Get" + suffix)
+    {
+        return sequential();
+    };
+    BENCHMARK("Interleaved Get" + suffix)
+    {
+        return interleaved();
+    };
+
+    // The speedup is reported, not required: it depends on the machine, on its caches and on the
+    // share of a lookup spent in the pager rather than waiting on memory.
+    auto time = [&](auto lookup)
+    {
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(lookup() == lookups);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto sequential_time  = time(sequential);
+    auto interleaved_time = time(interleaved);
+    WARN(count << " keys, height " << tree.height() << ", speedup of InterleavedLookup "
+               << sequential_time / interleaved_time);
+}
\ No newline at end of file
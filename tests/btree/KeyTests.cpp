@@ -0,0 +1,60 @@
+#include "mkvdb/btree/Key.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+
+TEST_CASE("CompareKeys The keys are ordered by their bytes as unsigned values")
+{
+    std::array<std::byte, 2> lhs = { std::byte { 0x01 }, std::byte { 0x7f } };
+    std::array<std::byte, 2> rhs = { std::byte { 0x01 }, std::byte { 0x80 } };
+
+    REQUIRE(CompareKeys(lhs, rhs) < 0);
+    REQUIRE(CompareKeys(rhs, lhs) > 0);
+    REQUIRE(CompareKeys(lhs, lhs) == 0);
+}
+
+TEST_CASE("CompareKeys A key is greater than its prefixes")
+{
+    std::array<std::byte, 2> key    = { std::byte { 0x01 }, std::byte { 0x00 } };
+    std::array<std::byte, 1> prefix = { std::byte { 0x01 } };
+
+    REQUIRE(CompareKeys(prefix, key) < 0);
+    REQUIRE(CompareKeys(key, prefix) > 0);
+    REQUIRE(CompareKeys(common::ConstByteSpan(), prefix) < 0);
+}
+
+TEST_CASE("CommonPrefixSize Returns the size of the prefix shared by two keys")
+{
+    std::array<std::byte, 3> lhs    = { std::byte { 1 }, std::byte { 2 }, std::byte { 3 } };
+    std::array<std::byte, 3> rhs    = { std::byte { 1 }, std::byte { 2 }, std::byte { 4 } };
+    std::array<std::byte, 2> prefix = { std::byte { 1 }, std::byte { 2 } };
+
+    REQUIRE(2 == CommonPrefixSize(lhs, rhs));
+    REQUIRE(2 == CommonPrefixSize(lhs, prefix));
+    REQUIRE(0 == CommonPrefixSize(lhs, common::ConstByteSpan()));
+}
+
+TEST_CASE("ShortestSeparatorSize The separator is greater than lhs and smaller or equal to rhs")
+{
+    std::array<std::byte, 4> lhs    = { std::byte { 1 },
+                                        std::byte { 2 },
+                                        std::byte { 3 },
+                                        std::byte { 9 } };
+    std::array<std::byte, 4> rhs    = { std::byte { 1 },
+                                        std::byte { 2 },
+                                        std::byte { 4 },
+                                        std::byte { 0 } };
+    std::array<std::byte, 2> prefix = { std::byte { 1 }, std::byte { 2 } };
+
+    auto actual    = ShortestSeparatorSize(lhs, rhs);
+    auto separator = common::ConstByteSpan(rhs).first(actual);
+
+    REQUIRE(3 == actual);
+    REQUIRE(CompareKeys(lhs, separator) < 0);
+    REQUIRE(CompareKeys(separator, rhs) <= 0);
+    REQUIRE(3 == ShortestSeparatorSize(prefix, rhs));
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "mkvdb/btree/KeyValueBatch.hpp"
+
+#include "../RandomBlob.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+TEST_CASE("KeyValueBatch::Append the pairs appended can be read back")
+{
+    std::vector<RandomBlob> keys   = { RandomBlob(4), RandomBlob(0), RandomBlob(12) };
+    std::vector<RandomBlob> values = { RandomBlob(42), RandomBlob(3), RandomBlob(0) };
+    KeyValueBatch sut;
+
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        sut.Append(keys[i].data(), values[i].data());
+    }
+
+    REQUIRE(keys.size() == sut.size());
+    REQUIRE(16 + 45 == sut.byte_size());
+    REQUIRE(keys.size() + 1 == sut.key_offsets().size());
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        REQUIRE_THAT(sut.key(i), Catch::Matchers::RangeEquals(keys[i].data()));
+        REQUIRE_THAT(sut.value(i), Catch::Matchers::RangeEquals(values[i].data()));
+    }
+}
+
+TEST_CASE("KeyValueBatch::Emplace returns the buffers of the new pair")
+{
+    RandomBlob key(12);
+    RandomBlob value(42);
+    KeyValueBatch sut;
+    sut.Append(RandomBlob(3).data(), RandomBlob(5).data());
+
+    auto [key_buffer, value_buffer] = sut.Emplace(key.size(), value.size());
+    std::copy(key.data().begin(), key.data().end(), key_buffer.begin());
+    std::copy(value.data().begin(), value.data().end(), value_buffer.begin());
+
+    REQUIRE(2 == sut.size());
+    REQUIRE_THAT(sut.key(1), Catch::Matchers::RangeEquals(key.data()));
+    REQUIRE_THAT(sut.value(1), Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("KeyValueBatch::PopBack removes the last pair")
+{
+    RandomBlob key(12);
+    RandomBlob value(42);
+    KeyValueBatch sut;
+    sut.Append(key.data(), value.data());
+    sut.Append(RandomBlob(3).data(), RandomBlob(5).data());
+
+    sut.PopBack();
+
+    REQUIRE(1 == sut.size());
+    REQUIRE(54 == sut.byte_size());
+    REQUIRE_THAT(sut.key(0), Catch::Matchers::RangeEquals(key.data()));
+    REQUIRE_THAT(sut.value(0), Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("KeyValueBatch::Clear removes all the pairs")
+{
+    KeyValueBatch sut;
+    sut.Append(RandomBlob(3).data(), RandomBlob(5).data());
+
+    sut.Clear();
+
+    REQUIRE(sut.empty());
+    REQUIRE(0 == sut.byte_size());
+}
\ No newline at end of file
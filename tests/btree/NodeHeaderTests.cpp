@@ -59,4 +59,120 @@ TEST_CASE("NodeHeader::unallocated_space Returns the size previously set")
     auto actual = sut.unallocated_space();
 
     REQUIRE(unallocated_space == actual);
+}
+
+TEST_CASE("NodeHeader::type Returns the type previously set")
+{
+    const NodeHeader::NodeType type =
+      GENERATE(NodeHeader::NodeType::Leaf, NodeHeader::NodeType::Inner);
+
+    std::array<std::byte, NodeHeader::HEADER_SIZE> buffer;
+    NodeHeader sut(buffer);
+
+    sut.type(type);
+    auto actual = sut.type();
+
+    REQUIRE(type == actual);
+}
+
+TEST_CASE("NodeHeader::right_child Returns the index previously set")
+{
+    pager::Page::PageIndex right_child =
+      GENERATE(UINT32_C(0), UINT32_MAX, take(10, random(UINT32_C(1), UINT32_MAX)));
+
+    std::array<std::byte, NodeHeader::HEADER_SIZE> buffer;
+    NodeHeader sut(buffer);
+
+    sut.right_child(right_child);
+    auto actual = sut.right_child();
+
+    REQUIRE(right_child == actual);
+}
+
+TEST_CASE("NodeHeader::prefix_size Returns the size previously set")
+{
+    NodeHeader::NodeSize prefix_size =
+      GENERATE(0,                                         // Minimum
+               std::numeric_limits<std::uint16_t>::max(), // Maximum
+               take(10, random(UINT16_C(0), UINT16_MAX))  // Random values
+      );
+
+    std::array<std::byte, NodeHeader::HEADER_SIZE> buffer;
+    NodeHeader sut(buffer);
+
+    sut.prefix_size(prefix_size);
+    auto actual = sut.prefix_size();
+
+    REQUIRE(prefix_size == actual);
+}
+
+TEST_CASE("NodeHeader::left_sibling Returns the index previously set")
+{
+    pager::Page::PageIndex left_sibling =
+      GENERATE(UINT32_C(0), UINT32_MAX, take(10, random(UINT32_C(1), UINT32_MAX)));
+
+    std::array<std::byte, NodeHeader::HEADER_SIZE> buffer;
+    NodeHeader sut(buffer);
+
+    sut.left_sibling(left_sibling);
+    auto actual = sut.left_sibling();
+
+    REQUIRE(left_sibling == actual);
+}
+
+TEST_CASE("NodeHeader::right_sibling Returns the index previously set")
+{
+    pager::Page::PageIndex right_sibling =
+      GENERATE(UINT32_C(0), UINT32_MAX, take(10, random(UINT32_C(1), UINT32_MAX)));
+
+    std::array<std::byte, NodeHeader::HEADER_SIZE> buffer;
+    NodeHeader sut(buffer);
+
+    sut.right_sibling(right_sibling);
+    auto actual = sut.right_sibling();
+
+    REQUIRE(right_sibling == actual);
+}
+
+TEST_CASE("NodeHeader stores its fields in big-endian order at their offsets in the page")
+{
+    std::array<std::byte, NodeHeader::HEADER_SIZE> buffer {};
+    NodeHeader sut(buffer);
+
+    sut.size(0x0102);
+    sut.byte_size(0x03040506);
+    sut.unallocated_space(0x0708);
+    sut.type(NodeHeader::NodeType::Inner);
+    sut.right_child(0x090a0b0c);
+    sut.prefix_size(0x0d0e);
+    sut.left_sibling(0x0f101112);
+    sut.right_sibling(0x13141516);
+
+    std::array<std::byte, NodeHeader::HEADER_SIZE> expected;
+    for(std::size_t i = 0; i < 8; ++i)
+    {
+        expected[i] = static_cast<std::byte>(i + 1);
+    }
+    expected[8] = std::byte { 2 };
+    for(std::size_t i = 9; i < NodeHeader::HEADER_SIZE; ++i)
+    {
+        expected[i] = static_cast<std::byte>(i);
+    }
+    REQUIRE(buffer == expected);
+}
+
+TEST_CASE("NodeHeader::size the size is stored in the byte order of the header")
+{
+    const std::endian byte_order = GENERATE(std::endian::big, std::endian::little);
+
+    std::array<std::byte, NodeHeader::HEADER_SIZE> buffer {};
+    NodeHeader sut(buffer, byte_order);
+
+    sut.size(0x0102);
+
+    auto expected = byte_order == std::endian::big ? std::array { std::byte(1), std::byte(2) }
+                                                   : std::array { std::byte(2), std::byte(1) };
+    REQUIRE(0x0102 == sut.size());
+    REQUIRE(expected[0] == buffer[0]);
+    REQUIRE(expected[1] == buffer[1]);
 }
\ No newline at end of file
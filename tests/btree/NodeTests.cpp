@@ -5,6 +5,11 @@
 #include "../RandomBlob.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <array>
+#include <vector>
 
 using namespace mkvdb;
 using namespace mkvdb::tests;
@@ -29,26 +34,327 @@ TEST_CASE(
     REQUIRE(expected_byte_size == actual_byte_size);
 }
 
-// TODO : Continue this test
-// TEST_CASE("Node::Insert After inserting a key/value pair, the size and byte_size are updated.")
-// {
-//     const common::FileOffset expected_size      = 1;
-//     const common::FileOffset expected_byte_size = 2;
-//     const pager::Page::PageIndex page_index     = 1;
-//     const pager::Page::PageSize page_size       = 512;
-//     const std::size_t key_size                  = 4;
-//     const std::size_t value_size                = 128;
-
-//     RandomBlob key(key_size);
-//     RandomBlob value(value_size);
-//     pager::Page page(page_index, page_size);
-//     Node node(page);
-//     node.InitializeNewNode();
-
-//     node.Insert(key.data(), value.data());
-//     auto actual_size      = node.size();
-//     auto actual_byte_size = node.byte_size();
-
-//     REQUIRE(expected_size == actual_size);
-//     REQUIRE(expected_byte_size == actual_byte_size);
-// }
+TEST_CASE("Node::Insert After inserting a key/value pair, the size and byte_size are updated.")
+{
+    const common::FileOffset expected_size  = 1;
+    const pager::Page::PageIndex page_index = 1;
+    const pager::Page::PageSize page_size   = 512;
+    const std::size_t key_size              = 4;
+    const std::size_t value_size            = 128;
+    const common::FileOffset expected_byte_size =
+      Cell::CalculateRequiredSize(key_size, value_size);
+
+    RandomBlob key(key_size);
+    RandomBlob value(value_size);
+    pager::Page page(page_index, page_size);
+    Node node(page);
+    node.InitializeNewNode();
+
+    node.Insert(key.data(), value.data());
+    auto actual_size      = node.size();
+    auto actual_byte_size = node.byte_size();
+
+    REQUIRE(expected_size == actual_size);
+    REQUIRE(expected_byte_size == actual_byte_size);
+}
+
+TEST_CASE("Node::Insert After inserting a key/value pair, the unallocated space is reduced.")
+{
+    const pager::Page::PageSize page_size = 512;
+    const std::size_t key_size            = 4;
+    const std::size_t value_size          = 128;
+
+    RandomBlob key(key_size);
+    RandomBlob value(value_size);
+    pager::Page page(1, page_size);
+    Node node(page);
+    node.InitializeNewNode();
+    auto initial = node.unallocated_space();
+
+    node.Insert(key.data(), value.data());
+    auto actual = node.unallocated_space();
+
+    REQUIRE(initial - Cell::CalculateRequiredSize(key_size, value_size) - SlotArray::SLOT_SIZE
+            == actual);
+    REQUIRE(actual == node.free_space());
+}
+
+TEST_CASE("Node::Insert Keys inserted in any order are kept sorted.")
+{
+    const std::uint8_t keys_count = 16;
+
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+
+    for(std::uint8_t i = 0; i < keys_count; ++i)
+    {
+        std::array<std::byte, 1> key = { static_cast<std::byte>((i * 7) % keys_count) };
+        RandomBlob value(4);
+        node.Insert(key, value.data());
+    }
+
+    REQUIRE(keys_count == node.size());
+    for(std::uint8_t i = 0; i < keys_count; ++i)
+    {
+        REQUIRE(static_cast<std::byte>(i) == node.SuffixAt(i)[0]);
+    }
+}
+
+TEST_CASE("Node::Insert The node is marked as modified.")
+{
+    RandomBlob key(4);
+    RandomBlob value(4);
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    page.MarkAsUnmodified();
+
+    node.Insert(key.data(), value.data());
+
+    REQUIRE(page.is_modified());
+}
+
+TEST_CASE("Node::Find Returns the position of a key in the node.")
+{
+    const std::uint8_t searched = GENERATE(0, 4, 8, 12);
+
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    RandomBlob value(4);
+    for(std::uint8_t i = 0; i <= 12; i += 2)
+    {
+        std::array<std::byte, 1> key = { static_cast<std::byte>(i) };
+        node.Insert(key, value.data());
+    }
+
+    std::array<std::byte, 1> key = { static_cast<std::byte>(searched) };
+    auto actual                  = node.Find(key);
+
+    REQUIRE(actual.found);
+    REQUIRE(searched / 2 == actual.position);
+}
+
+TEST_CASE("Node::Find Returns the position of the first greater key if the key is not found.")
+{
+    const std::uint8_t searched = GENERATE(1, 5, 13);
+
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    RandomBlob value(4);
+    for(std::uint8_t i = 0; i <= 12; i += 2)
+    {
+        std::array<std::byte, 1> key = { static_cast<std::byte>(i) };
+        node.Insert(key, value.data());
+    }
+
+    std::array<std::byte, 1> key = { static_cast<std::byte>(searched) };
+    auto actual                  = node.Find(key);
+
+    REQUIRE_FALSE(actual.found);
+    REQUIRE((searched + 1) / 2 == actual.position);
+}
+
+TEST_CASE("Node::Find A key that is a prefix of another key is smaller.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    RandomBlob value(4);
+    std::array<std::byte, 2> long_key  = { std::byte { 1 }, std::byte { 0 } };
+    std::array<std::byte, 1> short_key = { std::byte { 1 } };
+    node.Insert(long_key, value.data());
+
+    auto actual = node.Find(short_key);
+
+    REQUIRE_FALSE(actual.found);
+    REQUIRE(0 == actual.position);
+}
+
+TEST_CASE("Node::CanInsert Returns false once the node is full.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    RandomBlob value(100);
+    std::uint8_t count = 0;
+
+    while(node.CanInsert(1, value.size()))
+    {
+        std::array<std::byte, 1> key = { static_cast<std::byte>(count++) };
+        node.Insert(key, value.data());
+    }
+
+    REQUIRE(4 == count);
+    REQUIRE(node.unallocated_space()
+            < Cell::CalculateRequiredSize(1, value.size()) + SlotArray::SLOT_SIZE);
+}
+
+TEST_CASE("Node::Erase After erasing a cell, the other cells can still be read.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    RandomBlob value(4);
+    for(std::uint8_t i = 0; i < 3; ++i)
+    {
+        std::array<std::byte, 1> key = { static_cast<std::byte>(i) };
+        node.Insert(key, value.data());
+    }
+
+    node.Erase(1);
+
+    REQUIRE(2 == node.size());
+    REQUIRE(std::byte { 0 } == node.SuffixAt(0)[0]);
+    REQUIRE(std::byte { 2 } == node.SuffixAt(1)[0]);
+    REQUIRE(2 * Cell::CalculateRequiredSize(1, value.size()) == node.byte_size());
+}
+
+TEST_CASE("Node::Erase Erasing the last inserted cell gives its space back to the unallocated "
+          "space.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    RandomBlob key(4);
+    RandomBlob value(4);
+    auto initial = node.unallocated_space();
+
+    node.Insert(key.data(), value.data());
+    node.Erase(0);
+
+    REQUIRE(initial == node.unallocated_space());
+}
+
+TEST_CASE("Node::SetChildAt The children of an inner node can be read back.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode(NodeHeader::NodeType::Inner);
+    std::array<std::byte, 4> child = {};
+    std::array<std::byte, 1> key   = { std::byte { 42 } };
+    node.Insert(key, child);
+
+    node.SetChildAt(0, 7);
+    node.SetChildAt(1, 9);
+
+    REQUIRE(7 == node.ChildAt(0));
+    REQUIRE(9 == node.ChildAt(1));
+    REQUIRE(9 == node.right_child());
+}
+
+TEST_CASE("Node::FindChildPosition Keys equal to a separator are in the following child.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode(NodeHeader::NodeType::Inner);
+    std::array<std::byte, 4> child = {};
+    std::array<std::byte, 1> key   = { std::byte { 42 } };
+    std::array<std::byte, 1> lower = { std::byte { 41 } };
+    node.Insert(key, child);
+
+    REQUIRE(0 == node.FindChildPosition(lower));
+    REQUIRE(1 == node.FindChildPosition(key));
+}
+
+TEST_CASE("Node::Insert Only the suffix of the key is stored in the cell.")
+{
+    std::array<std::byte, 3> prefix = { std::byte { 1 }, std::byte { 2 }, std::byte { 3 } };
+    std::array<std::byte, 5> key    = { std::byte { 1 },
+                                        std::byte { 2 },
+                                        std::byte { 3 },
+                                        std::byte { 4 },
+                                        std::byte { 5 } };
+    RandomBlob value(4);
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode(NodeHeader::NodeType::Leaf, prefix);
+
+    node.Insert(key, value.data());
+    std::vector<std::byte> actual_key;
+    node.CopyKeyAt(0, actual_key);
+
+    REQUIRE(2 == node.SuffixAt(0).size());
+    REQUIRE(Cell::CalculateRequiredSize(2, value.size()) == node.byte_size());
+    REQUIRE_THAT(actual_key, Catch::Matchers::RangeEquals(key));
+}
+
+TEST_CASE("Node::Find Keys that do not start with the prefix are before or after all the keys.")
+{
+    std::array<std::byte, 2> prefix  = { std::byte { 5 }, std::byte { 5 } };
+    std::array<std::byte, 3> key     = { std::byte { 5 }, std::byte { 5 }, std::byte { 0 } };
+    std::array<std::byte, 1> shorter = { std::byte { 5 } };
+    std::array<std::byte, 3> lower   = { std::byte { 5 }, std::byte { 4 }, std::byte { 9 } };
+    std::array<std::byte, 1> greater = { std::byte { 6 } };
+    RandomBlob value(4);
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode(NodeHeader::NodeType::Leaf, prefix);
+    node.Insert(key, value.data());
+
+    REQUIRE(0 == node.Find(shorter).position);
+    REQUIRE(0 == node.Find(lower).position);
+    REQUIRE(1 == node.Find(greater).position);
+    REQUIRE(node.Find(key).found);
+}
+
+
+TEST_CASE("Node::Compact The holes of the erased cells are given back to the unallocated space.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    std::vector<RandomBlob> values;
+    for(std::uint8_t i = 0; i < 8; ++i)
+    {
+        std::array<std::byte, 1> key = { static_cast<std::byte>(i) };
+        values.emplace_back(10 + i);
+        node.Insert(key, values.back().data());
+    }
+    node.Erase(6);
+    node.Erase(3);
+    node.Erase(0);
+    auto byte_size = node.byte_size();
+    REQUIRE(node.unallocated_space() < node.free_space());
+
+    node.Compact();
+
+    REQUIRE(node.unallocated_space() == node.free_space());
+    REQUIRE(byte_size == node.byte_size());
+    REQUIRE(5 == node.size());
+    std::array<std::uint8_t, 5> remaining = { 1, 2, 4, 5, 7 };
+    for(NodeHeader::NodeSize i = 0; i < remaining.size(); ++i)
+    {
+        REQUIRE(std::byte { remaining[i] } == node.SuffixAt(i)[0]);
+        REQUIRE_THAT(node.ValueAt(i), Catch::Matchers::RangeEquals(values[remaining[i]].data()));
+    }
+}
+
+TEST_CASE("Node::Insert A cell that only fits in the free space is inserted after compacting.")
+{
+    pager::Page page(1, 512);
+    Node node(page);
+    node.InitializeNewNode();
+    RandomBlob value(100);
+    for(std::uint8_t i = 0; i < 4; ++i)
+    {
+        std::array<std::byte, 1> key = { static_cast<std::byte>(2 * i) };
+        node.Insert(key, value.data());
+    }
+    REQUIRE_FALSE(node.CanInsert(1, value.size()));
+
+    node.Erase(1);
+    std::array<std::byte, 1> key = { std::byte { 3 } };
+    REQUIRE(node.unallocated_space()
+            < Cell::CalculateRequiredSize(1, value.size()) + SlotArray::SLOT_SIZE);
+    REQUIRE(node.CanInsert(1, value.size()));
+
+    node.Insert(key, value.data());
+
+    REQUIRE(4 == node.size());
+    REQUIRE(std::byte { 3 } == node.SuffixAt(1)[0]);
+    REQUIRE(std::byte { 6 } == node.SuffixAt(3)[0]);
+    REQUIRE_THAT(node.ValueAt(1), Catch::Matchers::RangeEquals(value.data()));
+}
\ No newline at end of file
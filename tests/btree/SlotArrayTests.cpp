@@ -19,6 +19,7 @@ TEST_CASE(
     std::array<std::byte, buffer_size> buffer;
     NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
     header.size(0);
+    header.prefix_size(0);
     header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
     SlotArray sut(header, buffer);
 
@@ -40,6 +41,7 @@ TEST_CASE("SlotArray::At After inserting an offset it can be read back.")
     std::array<std::byte, buffer_size> buffer;
     NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
     header.size(0);
+    header.prefix_size(0);
     header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
     SlotArray sut(header, buffer);
 
@@ -58,6 +60,7 @@ TEST_CASE("SlotArray::At After inserting in the middle of the array the offset c
     std::array<std::byte, buffer_size> buffer;
     NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
     header.size(0);
+    header.prefix_size(0);
     header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
     SlotArray sut(header, buffer);
 
@@ -78,6 +81,7 @@ TEST_CASE("SlotArray::Erase After erasing the only offset the size of the node i
     std::array<std::byte, buffer_size> buffer;
     NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
     header.size(0);
+    header.prefix_size(0);
     header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
     SlotArray sut(header, buffer);
 
@@ -99,6 +103,7 @@ TEST_CASE(
     std::array<std::byte, buffer_size> buffer;
     NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
     header.size(0);
+    header.prefix_size(0);
     header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
     SlotArray sut(header, buffer);
 
@@ -119,11 +124,12 @@ TEST_CASE(
     const std::uint16_t insert_position = 0;
     const std::uint16_t offset_value    = 42;
     const std::uint16_t offset_number   = GENERATE(1, 2, 3);
-    const std::uint16_t offset_size     = 2;
+    const std::uint16_t slot_size       = SlotArray::SLOT_SIZE;
 
     std::array<std::byte, buffer_size> buffer;
     NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
     header.size(0);
+    header.prefix_size(0);
     header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
     SlotArray sut(header, buffer);
 
@@ -133,5 +139,105 @@ TEST_CASE(
     }
     auto actual = header.unallocated_space();
 
-    REQUIRE(buffer_size - NodeHeader::HEADER_SIZE - offset_number * offset_size == actual);
+    REQUIRE(buffer_size - NodeHeader::HEADER_SIZE - offset_number * slot_size == actual);
+}
+
+TEST_CASE("SlotArray::HeadAt The heads and the offsets stay together after inserts and erases.")
+{
+    const std::uint64_t buffer_size = 512;
+
+    std::array<std::byte, buffer_size> buffer;
+    NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
+    header.size(0);
+    header.prefix_size(0);
+    header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
+    SlotArray sut(header, buffer);
+
+    sut.Insert(0, 30, 3000);
+    sut.Insert(0, 10, 1000);
+    sut.Insert(1, 20, 2000);
+    sut.Insert(3, 40, 4000);
+    sut.Erase(2);
+
+    REQUIRE(3 == header.size());
+    REQUIRE(10 == sut.At(0));
+    REQUIRE(1000 == sut.HeadAt(0));
+    REQUIRE(20 == sut.At(1));
+    REQUIRE(2000 == sut.HeadAt(1));
+    REQUIRE(40 == sut.At(2));
+    REQUIRE(4000 == sut.HeadAt(2));
+}
+
+TEST_CASE("SlotArray::LowerBound Returns the position of the first head greater or equal.")
+{
+    const std::uint64_t buffer_size = 4096;
+    const std::uint16_t count       = GENERATE(0, 1, 7, 31, 32, 33, 200);
+    const std::uint32_t searched    = GENERATE(0, 1, 2, 99, 100, 101, 1000);
+
+    std::array<std::byte, buffer_size> buffer;
+    NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
+    header.size(0);
+    header.prefix_size(0);
+    header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
+    SlotArray sut(header, buffer);
+    for(std::uint16_t i = 0; i < count; ++i)
+    {
+        sut.Insert(i, i, i);
+    }
+
+    auto actual_lower = sut.LowerBound(searched);
+    auto actual_upper = sut.UpperBound(searched);
+
+    REQUIRE(std::min<std::uint32_t>(searched, count) == actual_lower);
+    REQUIRE(std::min<std::uint32_t>(searched + 1, count) == actual_upper);
+}
+
+TEST_CASE("SlotArray::Set The new offset can be read back and the head is unchanged.")
+{
+    const std::uint64_t buffer_size = 512;
+
+    std::array<std::byte, buffer_size> buffer;
+    NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE));
+    header.size(0);
+    header.prefix_size(0);
+    header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
+    SlotArray sut(header, buffer);
+    sut.Insert(0, 10, 100);
+    sut.Insert(1, 11, 101);
+    sut.Insert(2, 12, 102);
+
+    sut.Set(1, 42);
+
+    REQUIRE(10 == sut.At(0));
+    REQUIRE(42 == sut.At(1));
+    REQUIRE(12 == sut.At(2));
+    REQUIRE(101 == sut.HeadAt(1));
+}
+
+TEST_CASE("SlotArray::At the offsets are stored in the byte order of the header.")
+{
+    const std::uint64_t buffer_size = 512;
+    const std::uint16_t offset      = 0x0102;
+    const std::endian byte_order    = GENERATE(std::endian::big, std::endian::little);
+
+    std::array<std::byte, buffer_size> buffer {};
+    NodeHeader header(common::ByteSpan(buffer).subspan(0, NodeHeader::HEADER_SIZE), byte_order);
+    header.size(0);
+    header.prefix_size(0);
+    header.unallocated_space(buffer_size - NodeHeader::HEADER_SIZE);
+    SlotArray sut(header, buffer);
+
+    sut.Insert(0, offset, 0x0a0b0c0d);
+    sut.Insert(1, 42);
+    sut.Set(1, offset);
+
+    // The offsets follow the heads of the two slots.
+    auto offsets = NodeHeader::HEADER_SIZE + 2 * HEAD_SIZE;
+    auto first   = byte_order == std::endian::big ? std::byte(1) : std::byte(2);
+    REQUIRE(offset == sut.At(0));
+    REQUIRE(offset == sut.At(1));
+    REQUIRE(0x0a0b0c0d == sut.HeadAt(0));
+    REQUIRE(first == buffer[offsets]);
+    REQUIRE(first == buffer[offsets + SlotArray::PAGE_OFFSET_SIZE]);
+    REQUIRE(std::byte(0x0a) == buffer[NodeHeader::HEADER_SIZE]);
 }
\ No newline at end of file
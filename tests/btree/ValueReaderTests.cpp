@@ -0,0 +1,133 @@
+#include "mkvdb/btree/ValueReader.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../RandomBlob.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+TEST_CASE("ValueReader::Read reads a value by chunks")
+{
+    const std::size_t value_size = GENERATE(0, 10, 300, 5000, 100000);
+    const std::size_t chunk_size = 700;
+
+    RandomBlob key(12);
+    RandomBlob value(value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    tree.Put(key.data(), value.data());
+    pager.WriteModifiedPages();
+
+    auto sut = tree.OpenValueReader(key.data());
+    REQUIRE(sut.has_value());
+    std::vector<std::byte> actual;
+    std::vector<std::byte> chunk(chunk_size);
+    while(auto size = sut->Read(chunk))
+    {
+        actual.insert(actual.end(), chunk.begin(), chunk.begin() + size);
+    }
+
+    REQUIRE(value_size == sut->size());
+    REQUIRE(value_size == sut->position());
+    REQUIRE_THAT(actual, Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("ValueReader::Read does not add the overflow pages to the cache")
+{
+    const std::size_t value_size = 100000;
+    const std::size_t chunk_size = GENERATE(700, 100000);
+
+    RandomBlob key(12);
+    RandomBlob value(value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Page::PageIndex root_index;
+    {
+        pager::Pager pager(file);
+        root_index = BTree::Create(pager);
+        BTree tree(pager, root_index);
+        tree.Put(key.data(), value.data());
+        pager.WriteModifiedPages();
+    }
+    pager::Pager pager(file);
+    BTree tree(pager, root_index);
+
+    auto sut      = tree.OpenValueReader(key.data());
+    auto expected = pager.cached_pages_count();
+    std::vector<std::byte> chunk(chunk_size);
+    while(sut->Read(chunk) != 0)
+    {
+    }
+    auto result = pager.cached_pages_count();
+
+    REQUIRE(expected == result);
+}
+
+TEST_CASE("ValueReader::Seek reads a range of the value")
+{
+    const std::size_t value_size = GENERATE(300, 100000);
+    const std::size_t offset     = GENERATE(0, 7, 250, 4000, 60000);
+    const std::size_t size       = GENERATE(1, 100, 2000);
+
+    RandomBlob key(12);
+    RandomBlob value(value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    tree.Put(key.data(), value.data());
+    pager.WriteModifiedPages();
+    auto sut = tree.OpenValueReader(key.data());
+    REQUIRE(sut.has_value());
+
+    if(offset <= value_size)
+    {
+        std::vector<std::byte> actual(size);
+        sut->Seek(offset);
+        actual.resize(sut->Read(actual));
+
+        auto expected_size = std::min(size, value_size - offset);
+        REQUIRE(offset + expected_size == sut->position());
+        REQUIRE_THAT(
+          actual,
+          Catch::Matchers::RangeEquals(value.data().subspan(offset, expected_size)));
+    }
+    else
+    {
+        REQUIRE_THROWS_AS(sut->Seek(offset), common::MkvDBException);
+    }
+}
+
+TEST_CASE("BTree::OpenValueReader returns nothing if the key is not in the tree")
+{
+    RandomBlob key(12);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+
+    auto sut = tree.OpenValueReader(key.data());
+
+    REQUIRE_FALSE(sut.has_value());
+}
\ No newline at end of file
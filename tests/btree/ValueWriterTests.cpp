@@ -0,0 +1,137 @@
+#include "mkvdb/btree/ValueWriter.hpp"
+
+#include "mkvdb/btree/BTree.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+
+#include "mkvdb/fs/memory/MemoryFile.hpp"
+
+#include "mkvdb/pager/Header.hpp"
+#include "mkvdb/pager/Pager.hpp"
+
+#include "../RandomBlob.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+TEST_CASE("ValueWriter::Write a value written by chunks can be read back")
+{
+    const std::size_t value_size = GENERATE(0, 10, 300, 5000, 100000);
+    const std::size_t chunk_size = 333;
+
+    RandomBlob key(12);
+    RandomBlob value(value_size);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+
+    auto sut  = tree.OpenValueWriter(key.data(), value_size);
+    auto data = common::ConstByteSpan(value.data());
+    while(!data.empty())
+    {
+        auto size = std::min(chunk_size, data.size());
+        sut.Write(data.first(size));
+        data = data.subspan(size);
+    }
+    sut.Commit();
+    auto actual = tree.Get(key.data());
+
+    REQUIRE(value_size == sut.position());
+    REQUIRE(actual.has_value());
+    REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("ValueWriter::Write throws if the data goes past the size of the value")
+{
+    RandomBlob key(12);
+    RandomBlob value(2000);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    auto sut = tree.OpenValueWriter(key.data(), value.size() - 1);
+
+    REQUIRE_THROWS_AS(sut.Write(value.data()), common::MkvDBException);
+}
+
+TEST_CASE("ValueWriter::Commit throws if the value is not completely written")
+{
+    RandomBlob key(12);
+    RandomBlob value(2000);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    auto sut = tree.OpenValueWriter(key.data(), value.size() + 1);
+    sut.Write(value.data());
+
+    REQUIRE_THROWS_AS(sut.Commit(), common::MkvDBException);
+    REQUIRE_FALSE(tree.Get(key.data()).has_value());
+}
+
+TEST_CASE("ValueWriter::Commit replaces the previous value of the key")
+{
+    const std::size_t old_value_size = GENERATE(10, 5000);
+
+    RandomBlob key(12);
+    RandomBlob old_value(old_value_size);
+    RandomBlob value(3000);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    tree.Put(key.data(), old_value.data());
+
+    auto sut = tree.OpenValueWriter(key.data(), value.size());
+    sut.Write(value.data());
+    sut.Commit();
+    auto actual = tree.Get(key.data());
+
+    REQUIRE(actual.has_value());
+    REQUIRE_THAT(*actual, Catch::Matchers::RangeEquals(value.data()));
+}
+
+TEST_CASE("ValueWriter::~ValueWriter the overflow pages of a value not committed are freed")
+{
+    RandomBlob key(12);
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    auto first_new_page = pager.GetNewPage()->index() + 1;
+
+    {
+        auto sut = tree.OpenValueWriter(key.data(), 10 * 512);
+        sut.Write(RandomBlob(512).data());
+    }
+    auto actual = pager.GetNewPage()->index();
+
+    REQUIRE(first_new_page <= actual);
+    REQUIRE(actual < first_new_page + 10);
+    REQUIRE_FALSE(tree.Get(key.data()).has_value());
+}
+
+TEST_CASE("BTree::OpenValueWriter throws if the key is too large")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+    pager::Header::Initialize(file, 512);
+    pager::Pager pager(file);
+    BTree tree(pager, BTree::Create(pager));
+    RandomBlob large_key(tree.max_key_size() + 1);
+
+    REQUIRE_THROWS_AS(tree.OpenValueWriter(large_key.data(), 10), common::MkvDBException);
+}
\ No newline at end of file
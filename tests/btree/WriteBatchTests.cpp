@@ -0,0 +1,54 @@
+#include "mkvdb/btree/WriteBatch.hpp"
+
+#include "../RandomBlob.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <vector>
+
+using namespace mkvdb;
+using namespace mkvdb::btree;
+using namespace mkvdb::tests;
+
+TEST_CASE("WriteBatch::Put the operations added can be read back")
+{
+    RandomBlob put_key(4);
+    RandomBlob put_value(42);
+    RandomBlob delete_key(12);
+    RandomBlob empty_key(0);
+    WriteBatch sut;
+
+    sut.Put(put_key.data(), put_value.data());
+    sut.Delete(delete_key.data());
+    sut.Put(empty_key.data(), {});
+
+    REQUIRE(3 == sut.size());
+    REQUIRE(4 + 42 + 12 == sut.byte_size());
+    REQUIRE(WriteBatch::OperationType::Put == sut.type(0));
+    REQUIRE_THAT(sut.key(0), Catch::Matchers::RangeEquals(put_key.data()));
+    REQUIRE_THAT(sut.value(0), Catch::Matchers::RangeEquals(put_value.data()));
+    REQUIRE(WriteBatch::OperationType::Delete == sut.type(1));
+    REQUIRE_THAT(sut.key(1), Catch::Matchers::RangeEquals(delete_key.data()));
+    REQUIRE(sut.value(1).empty());
+    REQUIRE(WriteBatch::OperationType::Put == sut.type(2));
+    REQUIRE(sut.key(2).empty());
+    REQUIRE(sut.value(2).empty());
+}
+
+TEST_CASE("WriteBatch::Clear removes all the operations")
+{
+    WriteBatch sut;
+    sut.Put(RandomBlob(4).data(), RandomBlob(8).data());
+    sut.Delete(RandomBlob(4).data());
+
+    sut.Clear();
+
+    REQUIRE(sut.empty());
+    REQUIRE(0 == sut.byte_size());
+
+    RandomBlob key(3);
+    sut.Delete(key.data());
+    REQUIRE(1 == sut.size());
+    REQUIRE_THAT(sut.key(0), Catch::Matchers::RangeEquals(key.data()));
+}
\ No newline at end of file
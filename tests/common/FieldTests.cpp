@@ -0,0 +1,171 @@
+#include "mkvdb/common/Field.hpp"
+
+#include "mkvdb/common/Serialization.hpp"
+#include "mkvdb/common/Types.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace mkvdb::common;
+
+namespace
+{
+    enum class Color : std::uint8_t
+    {
+        Red  = 1,
+        Blue = 2
+    };
+
+    using ColorField = Field<0, Color>;
+    using SizeField  = NextField<ColorField, std::uint16_t>;
+    using IndexField = NextField<SizeField, std::uint32_t>;
+    using CountField = NextField<IndexField, std::uint64_t>;
+
+    /// Size of the records read by the benchmarks.
+    constexpr std::size_t RECORD_SIZE = CountField::END;
+
+    /// Number of records read by each benchmark.
+    constexpr std::size_t RECORDS_COUNT = 4096;
+} // namespace
+
+TEST_CASE("NextField places a field right after the previous one")
+{
+    STATIC_REQUIRE(SizeField::OFFSET == 1);
+    STATIC_REQUIRE(IndexField::OFFSET == 3);
+    STATIC_REQUIRE(CountField::OFFSET == 7);
+    STATIC_REQUIRE(CountField::END == 15);
+}
+
+TEST_CASE("Field::Write stores the value in big-endian order at the offset of the field")
+{
+    std::array<std::byte, RECORD_SIZE> buffer {};
+
+    IndexField::Write(buffer, 0x01020304);
+
+    std::array<std::byte, RECORD_SIZE> expected {};
+    expected[3] = std::byte { 0x01 };
+    expected[4] = std::byte { 0x02 };
+    expected[5] = std::byte { 0x03 };
+    expected[6] = std::byte { 0x04 };
+    REQUIRE(buffer == expected);
+    REQUIRE(Deserialize<std::uint32_t>(ConstByteSpan(buffer).subspan(IndexField::OFFSET)) ==
+            0x01020304);
+}
+
+TEST_CASE("Field::Write stores the value in little-endian order when asked")
+{
+    std::array<std::byte, RECORD_SIZE> buffer {};
+
+    IndexField::Write(buffer.data(), 0x01020304, std::endian::little);
+
+    std::array<std::byte, RECORD_SIZE> expected {};
+    expected[3] = std::byte { 0x04 };
+    expected[4] = std::byte { 0x03 };
+    expected[5] = std::byte { 0x02 };
+    expected[6] = std::byte { 0x01 };
+    REQUIRE(buffer == expected);
+}
+
+TEST_CASE("Field::Read returns the value previously written in the same byte order")
+{
+    const std::endian order = GENERATE(std::endian::big, std::endian::little);
+
+    std::array<std::byte, RECORD_SIZE> buffer {};
+
+    ColorField::Write(buffer.data(), Color::Red, order);
+    SizeField::Write(buffer.data(), 0xfedc, order);
+    CountField::Write(buffer.data(), 0x0123456789abcdef, order);
+
+    REQUIRE(ColorField::Read(buffer.data(), order) == Color::Red);
+    REQUIRE(SizeField::Read(buffer.data(), order) == 0xfedc);
+    REQUIRE(CountField::Read(buffer.data(), order) == 0x0123456789abcdef);
+}
+
+TEST_CASE("Field::Read returns the value previously written")
+{
+    std::array<std::byte, RECORD_SIZE> buffer {};
+
+    ColorField::Write(buffer, Color::Blue);
+    SizeField::Write(buffer, 0xfedc);
+    IndexField::Write(buffer, 0x89abcdef);
+    CountField::Write(buffer.data(), 0x0123456789abcdef);
+
+    REQUIRE(ColorField::Read(buffer) == Color::Blue);
+    REQUIRE(SizeField::Read(buffer) == 0xfedc);
+    REQUIRE(IndexField::Read(buffer.data()) == 0x89abcdef);
+    REQUIRE(CountField::Read(buffer) == 0x0123456789abcdef);
+}
+
+TEST_CASE("Field::Read compared to Deserialize", "[.benchmark]")
+{
+    std::vector<std::byte> records(RECORDS_COUNT * RECORD_SIZE);
+    ByteSpan span(records);
+    for(std::size_t i = 0; i < RECORDS_COUNT; ++i)
+    {
+        auto record = span.subspan(i * RECORD_SIZE, RECORD_SIZE);
+        SizeField::Write(record, static_cast<std::uint16_t>(i));
+        IndexField::Write(record, static_cast<std::uint32_t>(i * 3));
+    }
+
+    BENCHMARK("Deserialize")
+    {
+        std::uint64_t sum = 0;
+        for(std::size_t i = 0; i < RECORDS_COUNT; ++i)
+        {
+            auto record = span.subspan(i * RECORD_SIZE, RECORD_SIZE);
+            sum += Deserialize<std::uint16_t>(record.subspan(SizeField::OFFSET, SizeField::SIZE));
+            sum +=
+              Deserialize<std::uint32_t>(record.subspan(IndexField::OFFSET, IndexField::SIZE));
+        }
+        return sum;
+    };
+
+    BENCHMARK("Field::Read")
+    {
+        std::uint64_t sum = 0;
+        for(std::size_t i = 0; i < RECORDS_COUNT; ++i)
+        {
+            const std::byte* record = records.data() + i * RECORD_SIZE;
+            sum += SizeField::Read(record);
+            sum += IndexField::Read(record);
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("Field::Write compared to Serialize", "[.benchmark]")
+{
+    std::vector<std::byte> records(RECORDS_COUNT * RECORD_SIZE);
+    ByteSpan span(records);
+
+    BENCHMARK("Serialize")
+    {
+        for(std::size_t i = 0; i < RECORDS_COUNT; ++i)
+        {
+            auto record = span.subspan(i * RECORD_SIZE, RECORD_SIZE);
+            Serialize(static_cast<std::uint16_t>(i),
+                      record.subspan(SizeField::OFFSET, SizeField::SIZE));
+            Serialize(static_cast<std::uint32_t>(i),
+                      record.subspan(IndexField::OFFSET, IndexField::SIZE));
+        }
+        return records[RECORD_SIZE];
+    };
+
+    BENCHMARK("Field::Write")
+    {
+        for(std::size_t i = 0; i < RECORDS_COUNT; ++i)
+        {
+            std::byte* record = records.data() + i * RECORD_SIZE;
+            SizeField::Write(record, static_cast<std::uint16_t>(i));
+            IndexField::Write(record, static_cast<std::uint32_t>(i));
+        }
+        return records[RECORD_SIZE];
+    };
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "mkvdb/common/KeyEncoder.hpp"
+
+#include "mkvdb/common/MkvDBException.hpp"
+#include "mkvdb/common/Types.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace mkvdb::common;
+
+namespace
+{
+    /// Compare two encoded keys the way memcmp compares bytes, shorter keys first.
+    int CompareBytes(ConstByteSpan lhs, ConstByteSpan rhs)
+    {
+        auto result = std::memcmp(lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size()));
+        if(result != 0)
+        {
+            return result;
+        }
+        return lhs.size() < rhs.size() ? -1 : (lhs.size() > rhs.size() ? 1 : 0);
+    }
+
+    /// Encode values sorted in their logical order and check that their keys are sorted too.
+    template<typename T>
+    void CheckOrder(const std::vector<T>& sorted_values)
+    {
+        std::vector<std::vector<std::byte>> keys;
+        for(const auto& value : sorted_values)
+        {
+            KeyEncoder encoder;
+            if constexpr(requires { std::tuple_size<T>::value; })
+            {
+                encoder.AddTuple(value);
+            }
+            else
+            {
+                encoder.Add(value);
+            }
+            keys.emplace_back(encoder.key().begin(), encoder.key().end());
+        }
+
+        for(std::size_t i = 1; i < keys.size(); ++i)
+        {
+            REQUIRE(CompareBytes(keys[i - 1], keys[i]) < 0);
+        }
+    }
+} // namespace
+
+TEST_CASE("KeyEncoder::Add encodes unsigned integers in big-endian order")
+{
+    KeyEncoder encoder;
+    encoder.Add(std::uint16_t { 0x0102 }).Add(std::uint8_t { 0x03 });
+
+    std::vector<std::byte> expected { std::byte { 0x01 }, std::byte { 0x02 }, std::byte { 0x03 } };
+    REQUIRE(std::vector<std::byte>(encoder.key().begin(), encoder.key().end()) == expected);
+}
+
+TEST_CASE("KeyEncoder::Add preserves the order of signed integers")
+{
+    CheckOrder<std::int64_t>({ std::numeric_limits<std::int64_t>::min(),
+                               -1'000'000,
+                               -256,
+                               -1,
+                               0,
+                               1,
+                               255,
+                               1'000'000,
+                               std::numeric_limits<std::int64_t>::max() });
+    CheckOrder<std::int8_t>({ -128, -1, 0, 1, 127 });
+}
+
+TEST_CASE("KeyEncoder::Add preserves the order of floating-point numbers")
+{
+    constexpr auto INF = std::numeric_limits<double>::infinity();
+    CheckOrder<double>({ -INF,
+                         -1e300,
+                         -1.5,
+                         -std::numeric_limits<double>::denorm_min(),
+                         -0.0,
+                         0.0,
+                         std::numeric_limits<double>::denorm_min(),
+                         1.5,
+                         1e300,
+                         INF,
+                         std::numeric_limits<double>::quiet_NaN() });
+    CheckOrder<float>({ -2.5f, -0.5f, 0.0f, 0.5f, 2.5f });
+}
+
+TEST_CASE("KeyEncoder::Add encodes every NaN after the infinities")
+{
+    constexpr auto INF = std::numeric_limits<double>::infinity();
+    const double nan   = GENERATE(std::numeric_limits<double>::quiet_NaN(),
+                                -std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::signaling_NaN(),
+                                -std::numeric_limits<double>::signaling_NaN());
+
+    KeyEncoder expected;
+    expected.Add(std::numeric_limits<double>::quiet_NaN());
+    KeyEncoder encoder;
+    encoder.Add(nan);
+
+    REQUIRE_THAT(encoder.key(), Catch::Matchers::RangeEquals(expected.key()));
+    CheckOrder<double>({ -INF, INF, nan });
+}
+
+TEST_CASE("KeyEncoder::Add preserves the order of strings with zeros and prefixes")
+{
+    using namespace std::string_literals;
+    CheckOrder<std::string>({ ""s,
+                              "\0"s,
+                              "\0\0"s,
+                              "\0a"s,
+                              "\x01"s,
+                              "a"s,
+                              "a\0"s,
+                              "a\0\0"s,
+                              "a\0b"s,
+                              "a\x01"s,
+                              "ab"s,
+                              "b"s,
+                              "\xff"s });
+}
+
+TEST_CASE("KeyEncoder::AddTuple orders tuples by their values from left to right")
+{
+    using Tuple = std::tuple<std::string, std::int32_t, double>;
+    CheckOrder<Tuple>({ { "", -5, 0.0 },
+                        { "", 3, -1.0 },
+                        { "", 3, 2.0 },
+                        { "a", -100, 0.0 },
+                        { "a", 0, 0.0 },
+                        { std::string("a\0", 2), -100, 0.0 },
+                        { "ab", -200, -5.0 } });
+}
+
+TEST_CASE("KeyDecoder::ReadTuple decodes the values encoded")
+{
+    using namespace std::string_literals;
+    auto values = std::make_tuple(std::int16_t { -12 },
+                                  "x\0y\0"s,
+                                  std::uint64_t { 0x0123456789abcdef },
+                                  -0.25,
+                                  ""s,
+                                  std::int8_t { -128 },
+                                  3.5f);
+    KeyEncoder encoder;
+    encoder.AddTuple(values);
+
+    KeyDecoder decoder(encoder.key());
+    auto decoded = decoder
+                     .ReadTuple<std::int16_t, std::string, std::uint64_t, double, std::string,
+                                std::int8_t, float>();
+
+    REQUIRE(decoded == values);
+    REQUIRE(decoder.at_end());
+}
+
+TEST_CASE("KeyDecoder::ReadBytes decodes escaped bytes")
+{
+    std::vector<std::byte> value { std::byte { 0x00 }, std::byte { 0xff }, std::byte { 0x00 } };
+    KeyEncoder encoder;
+    encoder.AddBytes(value).Add(std::uint8_t { 7 });
+
+    KeyDecoder decoder(encoder.key());
+
+    REQUIRE(decoder.ReadBytes() == value);
+    REQUIRE(decoder.Read<std::uint8_t>() == 7);
+    REQUIRE(decoder.at_end());
+}
+
+TEST_CASE("KeyDecoder::Read throws if the key is truncated or invalid")
+{
+    KeyEncoder encoder;
+    encoder.Add(std::uint32_t { 1 }).Add("abc");
+    auto key = encoder.key();
+
+    KeyDecoder short_number(key.subspan(0, 3));
+    REQUIRE_THROWS_AS(short_number.Read<std::uint32_t>(), MkvDBException);
+
+    KeyDecoder short_string(key.subspan(0, key.size() - 1));
+    short_string.Read<std::uint32_t>();
+    REQUIRE_THROWS_AS(short_string.Read<std::string>(), MkvDBException);
+
+    std::vector<std::byte> invalid { std::byte { 'a' }, std::byte { 0x00 }, std::byte { 0x02 } };
+    KeyDecoder invalid_escape(invalid);
+    REQUIRE_THROWS_AS(invalid_escape.ReadBytes(), MkvDBException);
+}
\ No newline at end of file
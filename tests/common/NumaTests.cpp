@@ -0,0 +1,36 @@
+#include "mkvdb/common/Numa.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+using namespace mkvdb::common;
+
+TEST_CASE("NumaNodesCount returns at least one node")
+{
+    auto result = NumaNodesCount();
+
+    REQUIRE(1 <= result);
+}
+
+TEST_CASE("CurrentNumaNode returns a node less than the number of nodes")
+{
+    auto result = CurrentNumaNode();
+
+    REQUIRE(result < NumaNodesCount());
+}
+
+TEST_CASE("AllocateOnNumaNode returns zeroed memory that can be written")
+{
+    const std::size_t size = 4096;
+    const std::size_t node = GENERATE(ANY_NUMA_NODE, CurrentNumaNode());
+
+    auto memory = AllocateOnNumaNode(size, node);
+    bool is_zeroed = std::all_of(memory, memory + size, [](std::byte b) { return b == std::byte(0); });
+    std::fill(memory, memory + size, std::byte(42));
+    FreeNumaMemory(memory, size, node);
+
+    REQUIRE(is_zeroed);
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "mkvdb/common/ThreadPool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace mkvdb::common;
+
+TEST_CASE("ThreadPool::Submit executes the submitted tasks")
+{
+    const int tasks_count = 100;
+
+    std::atomic<int> executed = 0;
+    ThreadPool sut(4);
+    std::vector<std::future<void>> futures;
+
+    for(int x = 0; x < tasks_count; ++x)
+    {
+        futures.push_back(sut.Submit([&executed]() { ++executed; }));
+    }
+    for(auto& future : futures)
+    {
+        future.get();
+    }
+
+    REQUIRE(tasks_count == executed);
+}
+
+TEST_CASE("ThreadPool::Submit the exceptions thrown by a task are stored in its future")
+{
+    ThreadPool sut(1);
+
+    auto future = sut.Submit([]() { throw std::runtime_error("error"); });
+
+    REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool::~ThreadPool completes the tasks already submitted")
+{
+    const int tasks_count = 100;
+
+    std::atomic<int> executed = 0;
+    {
+        ThreadPool sut(2);
+        for(int x = 0; x < tasks_count; ++x)
+        {
+            sut.Submit([&executed]() { ++executed; });
+        }
+    }
+
+    REQUIRE(tasks_count == executed);
+}
\ No newline at end of file
@@ -61,6 +61,17 @@ TEST_CASE("MemoryFileWrite_NormalCase_NothingTrows")
     CHECK_NOTHROW(sut.Write(test_data.data(), 0));
 }
 
+TEST_CASE("MemoryFileWrite_FileOpenedReadOnly_Throws")
+{
+    mkvdb::tests::RandomBlob test_data;
+    MemoryFile sut;
+    sut.Create();
+    sut.Close();
+    sut.Open(mkvdb::fs::OpenMode::ReadOnly);
+
+    CHECK_THROWS_AS(sut.Write(test_data.data(), 0), mkvdb::common::MkvDBException);
+}
+
 TEST_CASE("MemoryFileWrite_FileNotOpened_Throws")
 {
     mkvdb::tests::RandomBlob test_data;
@@ -9,6 +9,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <cstddef>
+#include <filesystem>
 
 using namespace mkvdb::fs::posix;
 
@@ -88,6 +89,19 @@ TEST_CASE("PosixFileWrite_NormalCase_NothingTrows")
     CHECK_NOTHROW(sut.Write(test_data.data(), 0));
 }
 
+TEST_CASE("PosixFileWrite_FileOpenedReadOnly_Throws")
+{
+    mkvdb::tests::RandomBlob test_data;
+    mkvdb::tests::TemporaryFile temp_file;
+    PosixFile file(temp_file.filename());
+    file.Create();
+    file.Close();
+    PosixFile sut(temp_file.filename());
+    sut.Open(mkvdb::fs::OpenMode::ReadOnly);
+
+    CHECK_THROWS_AS(sut.Write(test_data.data(), 0), mkvdb::common::MkvDBException);
+}
+
 TEST_CASE("PosixFileWrite_FileNotOpened_Throws")
 {
     mkvdb::tests::RandomBlob test_data;
@@ -121,6 +135,24 @@ TEST_CASE("PosixFileRead_NormalCase_DataIsRead")
     REQUIRE(std::equal(test_data.begin(), test_data.end(), result.begin()));
 }
 
+TEST_CASE("PosixFileRead_FileOpenedReadOnly_DataIsRead")
+{
+    mkvdb::tests::RandomBlob test_data;
+    mkvdb::tests::TemporaryFile temp_file;
+    PosixFile file(temp_file.filename());
+    file.Create();
+    file.Write(test_data.data(), 0);
+    file.Close();
+    std::filesystem::permissions(temp_file.filename(), std::filesystem::perms::owner_read);
+    PosixFile sut(temp_file.filename());
+    sut.Open(mkvdb::fs::OpenMode::ReadOnly);
+    std::vector<std::byte> result(test_data.size());
+
+    sut.Read(mkvdb::common::ByteSpan(result.data(), result.size()), 0);
+
+    REQUIRE(std::equal(test_data.begin(), test_data.end(), result.begin()));
+}
+
 TEST_CASE("PosixFileRead_ReadDataWithAnOffset_DataIsRead")
 {
     mkvdb::tests::RandomBlob test_data;
@@ -135,6 +167,25 @@ TEST_CASE("PosixFileRead_ReadDataWithAnOffset_DataIsRead")
     REQUIRE(std::equal(test_data.begin(), test_data.end(), result.begin()));
 }
 
+TEST_CASE("PosixFileWillNeed_NormalCase_NothingThrows")
+{
+    mkvdb::tests::RandomBlob test_data;
+    mkvdb::tests::TemporaryFile temp_file;
+    PosixFile sut(temp_file.filename());
+    sut.Create();
+    sut.Write(test_data.data(), 0);
+
+    CHECK_NOTHROW(sut.WillNeed(0, test_data.size()));
+}
+
+TEST_CASE("PosixFileWillNeed_FileNotOpened_Throws")
+{
+    mkvdb::tests::TemporaryFile temp_file;
+    PosixFile sut(temp_file.filename());
+
+    CHECK_THROWS_AS(sut.WillNeed(0, 1024), mkvdb::common::MkvDBException);
+}
+
 TEST_CASE("PosixFileSync_NormalCase_NothingThrows")
 {
     mkvdb::tests::RandomBlob test_data;
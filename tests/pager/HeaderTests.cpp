@@ -1,5 +1,6 @@
 #include "mkvdb/pager/Header.hpp"
 
+#include "mkvdb/common/MkvDBException.hpp"
 #include "mkvdb/common/Serialization.hpp"
 #include "mkvdb/common/Types.hpp"
 
@@ -8,6 +9,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
+#include <bit>
 #include <cstddef>
 #include <tuple>
 
@@ -82,4 +84,62 @@ TEST_CASE("Header::pages_count(...) correctly changes the page count")
     sut.pages_count(new_count);
 
     REQUIRE(new_count == sut.pages_count());
+}
+
+TEST_CASE("Header::Initialize the free list is empty")
+{
+    Page::PageIndex expected = 0;
+
+    fs::memory::MemoryFile file;
+    file.Open();
+
+    Header::Initialize(file, 2048);
+
+    auto result = common::Deserialize<std::uint32_t>(file.data().subspan(21, 4));
+    REQUIRE(expected == result);
+}
+
+TEST_CASE("Header::first_free_page(...) correctly changes the first free page")
+{
+    auto page = std::make_shared<Page>(0, 512);
+    common::SerializeHex("6d6b7644422066696c652076310000000989c9c0f6", page->data());
+    Header sut(page);
+    Page::PageIndex new_index = 0x0910bc1e;
+
+    sut.first_free_page(new_index);
+
+    REQUIRE(new_index == sut.first_free_page());
+    REQUIRE(page->is_modified());
+}
+
+TEST_CASE("Header::Initialize the byte order can be read back")
+{
+    const std::endian expected = GENERATE(std::endian::big, std::endian::little);
+
+    fs::memory::MemoryFile file;
+    file.Open();
+
+    Header::Initialize(file, 2048, expected);
+
+    REQUIRE(expected == Header::ReadByteOrder(file));
+}
+
+TEST_CASE("Header::Initialize the default byte order is big-endian")
+{
+    fs::memory::MemoryFile file;
+    file.Open();
+
+    Header::Initialize(file, 2048);
+
+    REQUIRE(std::endian::big == Header::ReadByteOrder(file));
+    REQUIRE(std::byte(0) == file.data()[25]);
+}
+
+TEST_CASE("Header::ReadByteOrder throws if the byte order is unknown")
+{
+    fs::memory::MemoryFile file(
+      common::SerializeHex("6d6b7644422066696c6520763100000009000000010000000002"));
+    file.Open();
+
+    REQUIRE_THROWS_AS(Header::ReadByteOrder(file), common::MkvDBException);
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "mkvdb/pager/PageRing.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+using namespace mkvdb::pager;
+
+TEST_CASE("PageRing::Find returns nullptr when the page is not in the ring")
+{
+    PageRing sut(4, 512);
+
+    auto result = sut.Find(42);
+
+    REQUIRE(nullptr == result);
+}
+
+TEST_CASE("PageRing::Acquire returns a frame with the requested index that can be found")
+{
+    const Page::PageIndex index = 42;
+
+    PageRing sut(4, 512);
+    std::shared_ptr<Page> evicted;
+
+    auto page = sut.Acquire(index, evicted);
+    auto result = sut.Find(index);
+
+    REQUIRE(index == page->index());
+    REQUIRE(page == result);
+    REQUIRE(nullptr == evicted);
+}
+
+TEST_CASE("PageRing::Acquire recycles the frames that are not referenced elsewhere")
+{
+    const std::size_t capacity = 4;
+
+    PageRing sut(capacity, 512);
+    std::shared_ptr<Page> evicted;
+    Page* first_frame = sut.Acquire(0, evicted).get();
+    for(Page::PageIndex index = 1; index < capacity; ++index)
+    {
+        sut.Acquire(index, evicted);
+    }
+
+    auto page = sut.Acquire(capacity, evicted);
+
+    REQUIRE(first_frame == page.get());
+    REQUIRE(capacity == page->index());
+    REQUIRE(nullptr == sut.Find(0));
+    REQUIRE(nullptr == evicted);
+}
+
+TEST_CASE("PageRing::Acquire evicts the frames that are still referenced")
+{
+    const std::size_t capacity = 4;
+
+    PageRing sut(capacity, 512);
+    std::shared_ptr<Page> evicted;
+    auto first_page = sut.Acquire(0, evicted);
+    for(Page::PageIndex index = 1; index < capacity; ++index)
+    {
+        sut.Acquire(index, evicted);
+    }
+
+    auto page = sut.Acquire(capacity, evicted);
+
+    REQUIRE(first_page != page);
+    REQUIRE(first_page == evicted);
+    REQUIRE(0 == first_page->index());
+}
+
+TEST_CASE("PageRing::Acquire evicts the frames that are modified")
+{
+    const std::size_t capacity = 4;
+
+    PageRing sut(capacity, 512);
+    std::shared_ptr<Page> evicted;
+    sut.Acquire(0, evicted)->MarkAsModified();
+    for(Page::PageIndex index = 1; index < capacity; ++index)
+    {
+        sut.Acquire(index, evicted);
+    }
+
+    sut.Acquire(capacity, evicted);
+
+    REQUIRE(nullptr != evicted);
+    REQUIRE(0 == evicted->index());
+    REQUIRE(evicted->is_modified());
+}
+
+TEST_CASE("PageRing::Insert stores the page in place of the oldest frame")
+{
+    const std::size_t capacity = 4;
+
+    PageRing sut(capacity, 512);
+    std::shared_ptr<Page> evicted;
+    for(Page::PageIndex index = 0; index < capacity; ++index)
+    {
+        sut.Acquire(index, evicted);
+    }
+    auto page = std::make_shared<Page>(capacity, 512);
+
+    sut.Insert(page, evicted);
+
+    REQUIRE(page == sut.Find(capacity));
+    REQUIRE(nullptr == sut.Find(0));
+    REQUIRE(nullptr == evicted);
+}
+
+TEST_CASE("PageRing::Insert evicts the frames that are still referenced")
+{
+    const std::size_t capacity = 4;
+
+    PageRing sut(capacity, 512);
+    std::shared_ptr<Page> evicted;
+    auto first_page = sut.Acquire(0, evicted);
+    for(Page::PageIndex index = 1; index < capacity; ++index)
+    {
+        sut.Acquire(index, evicted);
+    }
+
+    sut.Insert(std::make_shared<Page>(capacity, 512), evicted);
+
+    REQUIRE(first_page == evicted);
+}
+
+TEST_CASE("PageRing::Remove removes the page from the ring")
+{
+    PageRing sut(4, 512);
+    std::shared_ptr<Page> evicted;
+    auto page = sut.Acquire(42, evicted);
+
+    auto result = sut.Remove(42);
+
+    REQUIRE(page == result);
+    REQUIRE(nullptr == sut.Find(42));
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "mkvdb/pager/PageTable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <memory>
+
+using namespace mkvdb::pager;
+
+TEST_CASE("PageTable::Find returns the pages inserted with every NUMA policy")
+{
+    const Page::PageIndex pages_count = 32;
+    const NumaPolicy numa_policy =
+      GENERATE(NumaPolicy::Disabled, NumaPolicy::LocalNode, NumaPolicy::HashToNode);
+
+    PageTable sut(numa_policy);
+    for(Page::PageIndex index = 0; index < pages_count; ++index)
+    {
+        sut.Insert(std::make_shared<Page>(index, 512, sut.NumaNodeFor(index)));
+    }
+
+    for(Page::PageIndex index = 0; index < pages_count; ++index)
+    {
+        auto page = sut.Find(index);
+
+        REQUIRE(nullptr != page);
+        REQUIRE(index == page->index());
+    }
+    REQUIRE(pages_count == sut.size());
+    REQUIRE(nullptr == sut.Find(pages_count));
+}
+
+TEST_CASE("PageTable::RecordHit counts the hits in the statistics of the current node")
+{
+    PageTable sut(NumaPolicy::LocalNode);
+    auto page = std::make_shared<Page>(42, 512, sut.NumaNodeFor(42));
+    sut.Insert(page);
+
+    sut.RecordHit(*page);
+    sut.RecordMiss();
+
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+    for(const auto& statistics : sut.statistics())
+    {
+        hits += statistics.hits;
+        misses += statistics.misses;
+    }
+    REQUIRE(1 == hits);
+    REQUIRE(1 == misses);
+}
+
+TEST_CASE("PageTable::ForEach visits every page")
+{
+    PageTable sut(NumaPolicy::HashToNode);
+    for(Page::PageIndex index = 0; index < 10; ++index)
+    {
+        sut.Insert(std::make_shared<Page>(index, 512, sut.NumaNodeFor(index)));
+    }
+
+    std::size_t result = 0;
+    sut.ForEach([&result](const std::shared_ptr<Page>&) { ++result; });
+
+    REQUIRE(10 == result);
+}
\ No newline at end of file
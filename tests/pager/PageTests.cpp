@@ -1,5 +1,7 @@
 #include "mkvdb/pager/Page.hpp"
 
+#include "mkvdb/common/MkvDBException.hpp"
+
 #include "mkvdb/pager/Header.hpp"
 
 #include "catch2/generators/catch_generators.hpp"
@@ -83,3 +85,24 @@ TEST_CASE("Page::is_modified() is false by default")
 
     REQUIRE(expected == result);
 }
+
+TEST_CASE("Page::MarkAsModified() throws if the page is read-only")
+{
+    Page sut(1, 512);
+    sut.MarkAsReadOnly();
+
+    REQUIRE_THROWS_AS(sut.MarkAsModified(), mkvdb::common::MkvDBException);
+}
+
+TEST_CASE("Page::Recycle() the page is not modified after being recycled")
+{
+    const Page::PageIndex index = 42;
+
+    Page sut(1, 512);
+    sut.MarkAsModified();
+
+    sut.Recycle(index);
+
+    REQUIRE(index == sut.index());
+    REQUIRE_FALSE(sut.is_modified());
+}
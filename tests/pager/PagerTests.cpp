@@ -1,9 +1,12 @@
 #include "mkvdb/pager/Pager.hpp"
 
+#include "mkvdb/common/MkvDBException.hpp"
+
 #include "mkvdb/fs/memory/MemoryFile.hpp"
 
 #include "mkvdb/pager/Header.hpp"
 
+#include "../CountingFile.hpp"
 #include "../RandomBlob.hpp"
 
 #include <catch2/catch_test_macros.hpp>
@@ -11,6 +14,7 @@
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
 
 #include <algorithm>
+#include <numeric>
 
 using namespace mkvdb::fs::memory;
 using namespace mkvdb::pager;
@@ -133,4 +137,631 @@ TEST_CASE("Pager::WriteModifiedPages pages not marked as modified are not writte
     REQUIRE_THAT(
       file.data().subspan(index * page_size, page_size),
       Catch::Matchers::RangeEquals(original_content.data().subspan(index * page_size, page_size)));
+}
+
+TEST_CASE("Pager::GetPage with a sequential access hint does not add the pages to the cache")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 64;
+
+    RandomBlob blob(page_size * page_count);
+    mkvdb::fs::memory::MemoryFile file;
+    file.Open();
+    file.Write(blob.data(), 0);
+    Header::Initialize(file, page_size);
+    Pager sut(file);
+    auto expected = sut.cached_pages_count();
+
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        sut.GetPage(index, AccessHint::Sequential);
+    }
+    auto result = sut.cached_pages_count();
+
+    REQUIRE(expected == result);
+}
+
+TEST_CASE("Pager::GetPage with a sequential access hint returns the correct page content")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 64;
+
+    RandomBlob blob(page_size * page_count);
+    mkvdb::fs::memory::MemoryFile file;
+    file.Open();
+    file.Write(blob.data(), 0);
+    Header::Initialize(file, page_size);
+    Pager sut(file);
+
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        auto page = sut.GetPage(index, AccessHint::Sequential);
+
+        REQUIRE(index == page->index());
+        REQUIRE_THAT(
+          page->data(),
+          Catch::Matchers::RangeEquals(blob.data().subspan(page_size * index, page_size)));
+    }
+}
+
+TEST_CASE("Pager::GetPage with a sequential access hint returns pages already in the cache")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 3;
+    const Page::PageIndex index      = 1;
+
+    RandomBlob blob(page_size * page_count);
+    mkvdb::fs::memory::MemoryFile file;
+    file.Open();
+    file.Write(blob.data(), 0);
+    Header::Initialize(file, page_size);
+    Pager sut(file);
+    auto expected = sut.GetPage(index);
+
+    auto result = sut.GetPage(index, AccessHint::Sequential);
+
+    REQUIRE(expected == result);
+}
+
+TEST_CASE("Pager::GetPage a page read sequentially is moved to the cache by a normal access")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 3;
+    const Page::PageIndex index      = 1;
+
+    RandomBlob blob(page_size * page_count);
+    mkvdb::fs::memory::MemoryFile file;
+    file.Open();
+    file.Write(blob.data(), 0);
+    Header::Initialize(file, page_size);
+    Pager sut(file);
+    auto expected_count = sut.cached_pages_count() + 1;
+    auto expected       = sut.GetPage(index, AccessHint::Sequential);
+
+    auto result       = sut.GetPage(index);
+    auto result_count = sut.cached_pages_count();
+
+    REQUIRE(expected == result);
+    REQUIRE(expected_count == result_count);
+}
+
+TEST_CASE("Pager::WriteModifiedPages write the pages modified after a sequential access")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 64;
+    const Page::PageIndex index      = 1;
+
+    RandomBlob original_content(page_size * page_count);
+    RandomBlob modified_page_content(page_size);
+    mkvdb::fs::memory::MemoryFile file;
+    file.Open();
+    file.Write(original_content.data(), 0);
+    Header::Initialize(file, page_size);
+    Pager sut(file);
+
+    auto page = sut.GetPage(index, AccessHint::Sequential);
+    std::copy(modified_page_content.data().begin(),
+              modified_page_content.data().end(),
+              page->data().begin());
+    page->MarkAsModified();
+    page.reset();
+    for(Page::PageIndex other = index + 1; other < page_count; ++other)
+    {
+        sut.GetPage(other, AccessHint::Sequential);
+    }
+    sut.WriteModifiedPages();
+
+    REQUIRE_THAT(file.data().subspan(index * page_size, page_size),
+                 Catch::Matchers::RangeEquals(modified_page_content.data()));
+}
+
+namespace
+{
+    /// Initialize a file containing page_count pages of random content.
+    RandomBlob InitializeFileWithPages(mkvdb::fs::IFile& file,
+                                       Page::PageSize page_size,
+                                       Page::PageIndex page_count)
+    {
+        file.Open();
+        Header::Initialize(file, page_size);
+        {
+            Pager pager(file);
+            for(Page::PageIndex x = 1; x < page_count; ++x)
+            {
+                pager.GetNewPage()->MarkAsModified();
+            }
+            pager.WriteModifiedPages();
+        }
+
+        RandomBlob blob(page_size * page_count);
+        file.Write(blob.data().subspan(page_size), page_size);
+        return blob;
+    }
+} // namespace
+
+TEST_CASE("Pager::GetPage reads sequential runs of pages with fewer requests")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 128;
+
+    CountingFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    file.ResetCounters();
+
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        sut.GetPage(index);
+    }
+
+    REQUIRE(file.reads_count() < (page_count - 1) / 4);
+    REQUIRE(file.bytes_read() == (page_count - 1) * page_size);
+}
+
+TEST_CASE("Pager::GetPage reads a single page for the first page read after opening")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 16;
+
+    CountingFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    file.ResetCounters();
+
+    sut.GetPage(1);
+
+    REQUIRE(page_size == file.bytes_read());
+}
+
+TEST_CASE("Pager::GetPage reads pages one at a time when the accesses are not sequential")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 128;
+
+    CountingFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    file.ResetCounters();
+
+    for(Page::PageIndex index = page_count - 1; index > 0; --index)
+    {
+        sut.GetPage(index);
+    }
+
+    REQUIRE(file.bytes_read() == file.reads_count() * page_size);
+}
+
+TEST_CASE("Pager::GetPage returns the correct content of pages read ahead")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 128;
+    const AccessHint hint            = GENERATE(AccessHint::Normal, AccessHint::Sequential);
+
+    MemoryFile file;
+    auto blob = InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        auto page = sut.GetPage(index, hint);
+
+        REQUIRE(index == page->index());
+        REQUIRE_THAT(
+          page->data(),
+          Catch::Matchers::RangeEquals(blob.data().subspan(page_size * index, page_size)));
+    }
+}
+
+TEST_CASE("Pager::GetPage does not read ahead pages that are not in the file yet")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 4;
+
+    MemoryFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    for(Page::PageIndex x = 0; x < 8; ++x)
+    {
+        sut.GetNewPage();
+    }
+
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        CHECK_NOTHROW(sut.GetPage(index));
+    }
+}
+
+TEST_CASE("Pager::Prefetch the pages prefetched are returned by GetPage with the correct content")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 16;
+    const std::vector<Page::PageIndex> indexes { 7, 3, 12, 4, 5 };
+
+    MemoryFile file;
+    auto blob = InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+
+    sut.Prefetch(indexes);
+
+    for(auto index : indexes)
+    {
+        auto page = sut.GetPage(index);
+
+        REQUIRE(index == page->index());
+        REQUIRE_THAT(
+          page->data(),
+          Catch::Matchers::RangeEquals(blob.data().subspan(page_size * index, page_size)));
+    }
+}
+
+TEST_CASE("Pager::Prefetch consecutive pages are read in a single request")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 16;
+    const std::vector<Page::PageIndex> indexes { 3, 4, 5, 6 };
+
+    CountingFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    file.ResetCounters();
+
+    sut.Prefetch(indexes);
+    for(auto index : indexes)
+    {
+        sut.GetPage(index);
+    }
+
+    REQUIRE(1 == file.reads_count());
+}
+
+TEST_CASE("Pager::Prefetch pages already loaded are not read again")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 16;
+    const std::vector<Page::PageIndex> indexes { 3 };
+
+    CountingFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    sut.GetPage(3);
+    file.ResetCounters();
+
+    sut.Prefetch(indexes);
+    sut.GetPage(3);
+
+    REQUIRE(0 == file.reads_count());
+}
+
+TEST_CASE("Pager::Prefetch pages that are not in the file are ignored")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 4;
+    const std::vector<Page::PageIndex> indexes { 3, 4, 5, 1000 };
+
+    CountingFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    file.ResetCounters();
+
+    sut.Prefetch(indexes);
+    sut.GetPage(3);
+
+    REQUIRE(1 == file.reads_count());
+    REQUIRE(page_size == file.bytes_read());
+}
+
+TEST_CASE("Pager::Prefetch with a sequential access hint does not add the pages to the cache")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 64;
+
+    MemoryFile file;
+    auto blob = InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    auto expected = sut.cached_pages_count();
+    std::vector<Page::PageIndex> indexes;
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        indexes.push_back(index);
+    }
+
+    sut.Prefetch(indexes, AccessHint::Sequential);
+    for(auto index : indexes)
+    {
+        auto page = sut.GetPage(index, AccessHint::Sequential);
+
+        REQUIRE_THAT(
+          page->data(),
+          Catch::Matchers::RangeEquals(blob.data().subspan(page_size * index, page_size)));
+    }
+    auto result = sut.cached_pages_count();
+
+    REQUIRE(expected == result);
+}
+
+TEST_CASE("Pager::Prefetch with a sequential access hint drops the pages that are not requested")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 64;
+    const std::vector<Page::PageIndex> indexes { 3, 4, 5, 6 };
+
+    MemoryFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+
+    sut.Prefetch(indexes, AccessHint::Sequential);
+    auto expected = sut.cached_pages_count() + 1;
+    sut.GetNewPage()->MarkAsModified();
+    sut.WriteModifiedPages();
+    auto result = sut.cached_pages_count();
+
+    REQUIRE(expected == result);
+}
+
+TEST_CASE("Pager::Prefetch the pages never requested are collected in read-only mode")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 32768;
+    const Page::PageIndex batch_size = 64;
+    const AccessHint hint            = GENERATE(AccessHint::Normal, AccessHint::Sequential);
+
+    MemoryFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    file.Close();
+    file.Open(mkvdb::fs::OpenMode::ReadOnly);
+    Pager sut(file);
+
+    std::size_t max_pending_reads = 0;
+    for(Page::PageIndex first = 1; first + batch_size <= page_count; first += batch_size)
+    {
+        std::vector<Page::PageIndex> indexes(batch_size);
+        std::iota(indexes.begin(), indexes.end(), first);
+        sut.Prefetch(indexes, hint);
+        max_pending_reads = std::max(max_pending_reads, sut.pending_reads_count());
+    }
+
+    REQUIRE(max_pending_reads < page_count / 2);
+}
+
+TEST_CASE("Pager::WriteModifiedPages can be called while pages are prefetched")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 64;
+
+    MemoryFile file;
+    auto blob = InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file);
+    std::vector<Page::PageIndex> indexes;
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        indexes.push_back(index);
+    }
+
+    sut.Prefetch(indexes);
+    sut.GetNewPage()->MarkAsModified();
+    sut.WriteModifiedPages();
+    auto page = sut.GetPage(page_count - 1);
+
+    REQUIRE_THAT(page->data(),
+                 Catch::Matchers::RangeEquals(
+                   blob.data().subspan(page_size * (page_count - 1), page_size)));
+}
+
+TEST_CASE("Pager::GetPage in read-only mode returns read-only pages")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 16;
+    const AccessHint hint            = GENERATE(AccessHint::Normal, AccessHint::Sequential);
+
+    MemoryFile file;
+    auto blob = InitializeFileWithPages(file, page_size, page_count);
+    file.Close();
+    file.Open(mkvdb::fs::OpenMode::ReadOnly);
+    Pager sut(file);
+
+    for(Page::PageIndex index = 1; index < page_count; ++index)
+    {
+        auto page = sut.GetPage(index, hint);
+
+        REQUIRE(page->is_read_only());
+        REQUIRE_THAT(
+          page->data(),
+          Catch::Matchers::RangeEquals(blob.data().subspan(page_size * index, page_size)));
+    }
+}
+
+TEST_CASE("Pager::GetNewPage throws in read-only mode")
+{
+    MemoryFile file;
+    InitializeFileWithPages(file, 512, 4);
+    file.Close();
+    file.Open(mkvdb::fs::OpenMode::ReadOnly);
+    Pager sut(file);
+
+    REQUIRE(sut.is_read_only());
+    REQUIRE_THROWS_AS(sut.GetNewPage(), mkvdb::common::MkvDBException);
+}
+
+TEST_CASE("Pager::WriteModifiedPages throws in read-only mode")
+{
+    MemoryFile file;
+    InitializeFileWithPages(file, 512, 4);
+    file.Close();
+    file.Open(mkvdb::fs::OpenMode::ReadOnly);
+    Pager sut(file);
+
+    REQUIRE_THROWS_AS(sut.WriteModifiedPages(), mkvdb::common::MkvDBException);
+}
+
+TEST_CASE("Pager::GetPage returns the correct page content with every NUMA policy")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 16;
+    const NumaPolicy numa_policy =
+      GENERATE(NumaPolicy::Disabled, NumaPolicy::LocalNode, NumaPolicy::HashToNode);
+
+    MemoryFile file;
+    auto blob = InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file, numa_policy);
+
+    for(Page::PageIndex index = page_count - 1; index > 0; --index)
+    {
+        auto page = sut.GetPage(index);
+
+        REQUIRE(index == page->index());
+        REQUIRE_THAT(
+          page->data(),
+          Catch::Matchers::RangeEquals(blob.data().subspan(page_size * index, page_size)));
+    }
+}
+
+TEST_CASE("Pager::statistics counts the hits and misses of the pages cache")
+{
+    const Page::PageSize page_size   = 512;
+    const Page::PageIndex page_count = 16;
+    const NumaPolicy numa_policy =
+      GENERATE(NumaPolicy::Disabled, NumaPolicy::LocalNode, NumaPolicy::HashToNode);
+
+    MemoryFile file;
+    InitializeFileWithPages(file, page_size, page_count);
+    Pager sut(file, numa_policy);
+    auto initial = sut.statistics();
+
+    sut.GetPage(5);
+    sut.GetPage(5);
+    sut.GetPage(9);
+    sut.GetPage(5);
+
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+    for(std::size_t node = 0; node < initial.size(); ++node)
+    {
+        hits += sut.statistics()[node].hits + sut.statistics()[node].remote_hits -
+                initial[node].hits - initial[node].remote_hits;
+        misses += sut.statistics()[node].misses - initial[node].misses;
+    }
+    REQUIRE(2 == hits);
+    REQUIRE(2 == misses);
+}
+
+TEST_CASE("Pager::GetNewPages returns consecutive pages after the last page")
+{
+    MemoryFile file;
+    file.Open();
+    Header::Initialize(file, 512);
+    Pager sut(file);
+    sut.GetNewPage();
+
+    auto pages = sut.GetNewPages(5);
+
+    REQUIRE(5 == pages.size());
+    for(Page::PageIndex i = 0; i < pages.size(); ++i)
+    {
+        REQUIRE(2 + i == pages[i]->index());
+    }
+    REQUIRE(7 == sut.GetNewPage()->index());
+}
+
+TEST_CASE("Pager::GetNewPage reuses the pages freed, the last freed first")
+{
+    MemoryFile file;
+    file.Open();
+    Header::Initialize(file, 512);
+    Pager sut(file);
+    sut.GetNewPages(4);
+
+    sut.FreePage(2);
+    sut.FreePage(4);
+
+    REQUIRE(4 == sut.GetNewPage()->index());
+    REQUIRE(2 == sut.GetNewPage()->index());
+    REQUIRE(5 == sut.GetNewPage()->index());
+}
+
+TEST_CASE("Pager::GetNewPages does not reuse the extents of the free list that are too small")
+{
+    MemoryFile file;
+    file.Open();
+    Header::Initialize(file, 512);
+    Pager sut(file);
+    sut.GetNewPages(4);
+    sut.FreePage(2);
+
+    auto pages = sut.GetNewPages(2);
+
+    REQUIRE(5 == pages.front()->index());
+    REQUIRE(2 == sut.GetNewPage()->index());
+}
+
+TEST_CASE("Pager::GetNewPages reuses the first extent of the free list large enough")
+{
+    const Page::PageIndex count = GENERATE(3, 5);
+
+    MemoryFile file;
+    file.Open();
+    Header::Initialize(file, 512);
+    Pager sut(file);
+    sut.GetNewPages(12);
+    sut.FreePages(2, 5);
+    sut.FreePage(10);
+
+    auto pages = sut.GetNewPages(count);
+
+    REQUIRE(count == pages.size());
+    for(Page::PageIndex i = 0; i < pages.size(); ++i)
+    {
+        REQUIRE(7 - count + i == pages[i]->index());
+    }
+    REQUIRE(13 == sut.GetNewPages(8).front()->index());
+}
+
+TEST_CASE("Pager::GetNewPage takes the pages of an extent freed at once from its end")
+{
+    MemoryFile file;
+    file.Open();
+    Header::Initialize(file, 512);
+    Pager sut(file);
+    sut.GetNewPages(4);
+
+    sut.FreePages(2, 3);
+
+    REQUIRE(4 == sut.GetNewPage()->index());
+    REQUIRE(3 == sut.GetNewPage()->index());
+    REQUIRE(2 == sut.GetNewPage()->index());
+    REQUIRE(5 == sut.GetNewPage()->index());
+}
+
+TEST_CASE("Pager::FreePage the free list is kept when the pager is reopened")
+{
+    MemoryFile file;
+    file.Open();
+    Header::Initialize(file, 512);
+    {
+        Pager pager(file);
+        for(auto& page : pager.GetNewPages(4))
+        {
+            page->MarkAsModified();
+        }
+        pager.FreePage(1);
+        pager.FreePage(3);
+        pager.WriteModifiedPages();
+    }
+
+    Pager sut(file);
+
+    REQUIRE(3 == sut.GetNewPage()->index());
+    REQUIRE(1 == sut.GetNewPage()->index());
+    REQUIRE(5 == sut.GetNewPage()->index());
+}
+
+TEST_CASE("Pager::GetNewPages and Pager::FreePage throw in read-only mode")
+{
+    MemoryFile file;
+    InitializeFileWithPages(file, 512, 4);
+    file.Close();
+    file.Open(mkvdb::fs::OpenMode::ReadOnly);
+    Pager sut(file);
+
+    REQUIRE_THROWS_AS(sut.GetNewPages(2), mkvdb::common::MkvDBException);
+    REQUIRE_THROWS_AS(sut.FreePage(1), mkvdb::common::MkvDBException);
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "mkvdb/pager/Readahead.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace mkvdb::pager;
+
+TEST_CASE("Readahead::OnRead returns a single page for the first read")
+{
+    Readahead sut(64);
+
+    auto result = sut.OnRead(42);
+
+    REQUIRE(1 == result);
+}
+
+TEST_CASE("Readahead::OnRead doubles the window while the reads are sequential")
+{
+    Readahead sut(64);
+    Page::PageIndex index = 1;
+
+    for(Page::PageIndex expected : { 1, 2, 4, 8, 16, 32, 64, 64 })
+    {
+        auto result = sut.OnRead(index);
+        sut.OnPagesRead(index, result);
+        index += result;
+
+        REQUIRE(expected == result);
+    }
+}
+
+TEST_CASE("Readahead::OnRead resets the window when the reads are not sequential")
+{
+    Readahead sut(64);
+    sut.OnPagesRead(1, sut.OnRead(1));
+    sut.OnPagesRead(2, sut.OnRead(2));
+
+    auto result = sut.OnRead(42);
+
+    REQUIRE(1 == result);
+}
+
+TEST_CASE("Readahead::OnRead continues after the pages actually read")
+{
+    Readahead sut(64);
+    sut.OnPagesRead(1, sut.OnRead(1));
+    sut.OnRead(2);
+    sut.OnPagesRead(2, 1);
+
+    auto result = sut.OnRead(3);
+
+    REQUIRE(4 == result);
+}
+
+TEST_CASE("Readahead::OnRead a read of the header does not start a sequential run")
+{
+    Readahead sut(64);
+    sut.OnPagesRead(0, sut.OnRead(0));
+
+    auto result = sut.OnRead(1);
+
+    REQUIRE(1 == result);
+}
\ No newline at end of file